@@ -0,0 +1,53 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <cstdint>
+
+// A set of grid cells, one bit per cell in row-major order (y * width + x),
+// held in 3 x uint64_t = 192 bits; the 13x10 board uses bits 0-129. See the
+// flood-fill notes in wordescape.cpp for how the shifts map to neighbors.
+struct BitBoard {
+  uint64_t w[3] = {};
+
+  constexpr void set(int pos) { w[pos >> 6] |= 1ULL << (pos & 63); }
+  constexpr void clear(int pos) { w[pos >> 6] &= ~(1ULL << (pos & 63)); }
+  constexpr bool test(int pos) const { return w[pos >> 6] & (1ULL << (pos & 63)); }
+
+  constexpr BitBoard operator|(const BitBoard& o) const { return {{w[0]|o.w[0], w[1]|o.w[1], w[2]|o.w[2]}}; }
+  constexpr BitBoard operator&(const BitBoard& o) const { return {{w[0]&o.w[0], w[1]&o.w[1], w[2]&o.w[2]}}; }
+  constexpr BitBoard operator~() const { return {{~w[0], ~w[1], ~w[2]}}; }
+  constexpr BitBoard& operator|=(const BitBoard& o) { w[0]|=o.w[0]; w[1]|=o.w[1]; w[2]|=o.w[2]; return *this; }
+  constexpr bool any() const { return w[0] | w[1] | w[2]; }
+
+  // Shift right by n bits (n < 64). Equivalent to >> on a 192-bit integer.
+  // Cross-word carry: low bits of w[i+1] flow into high bits of w[i].
+  constexpr BitBoard shr(int n) const {
+    return {{(w[0] >> n) | (w[1] << (64 - n)),
+             (w[1] >> n) | (w[2] << (64 - n)),
+             w[2] >> n}};
+  }
+
+  // Shift left by n bits (n < 64). Equivalent to << on a 192-bit integer.
+  // Cross-word carry: high bits of w[i] flow into low bits of w[i+1].
+  constexpr BitBoard shl(int n) const {
+    return {{w[0] << n,
+             (w[1] << n) | (w[0] >> (64 - n)),
+             (w[2] << n) | (w[1] >> (64 - n))}};
+  }
+
+  // Iterate over set bits, calling f(bit_position) for each.
+  // Uses the "clear lowest set bit" trick: bits &= bits - 1.
+  template<typename F>
+  void for_each_bit(F&& f) const {
+    for (int i = 0; i < 3; i++) {
+      uint64_t bits = w[i];
+      while (bits) {
+        int bit = __builtin_ctzll(bits);
+        f(i * 64 + bit);
+        bits &= bits - 1;
+      }
+    }
+  }
+};
+
+#endif
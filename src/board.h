@@ -9,6 +9,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "bitboard.h"
 #include "coordinate-list.h"
 #include "grid.h"
 #include "inline-bitset.h"
@@ -302,6 +303,28 @@ class BoardStatic {
   std::vector<int> mLegalWordScratchGeneration;
   int mCurrentScratchGeneration;
 
+  // The cells each legal word covers, indexed by renumbered maximizer /
+  // minimizer goodness so that a scan in move order reads them
+  // sequentially (see WordBaseState::fill_capture_moves).
+  std::vector<BitBoard> mMaximizerWordCellMasks;
+  std::vector<BitBoard> mMinimizerWordCellMasks;
+
+  // Every bomb and megabomb cell at the start of the game.
+  BitBoard mBombCellMask;
+
+  // The words whose path touches the enemy home row, i.e. that win the
+  // game when played: bit k of mMaximizerGoalWordBits is the word with
+  // renumbered maximizer goodness k (a path into row kBoardHeight - 1),
+  // and likewise for the minimizer (row 0). Only the first
+  // m*GoalWordSpan 64-bit words have bits, and only the
+  // m*GoalStartCells cells start a goal word.
+  InlineBitset mMaximizerGoalWordBits;
+  InlineBitset mMinimizerGoalWordBits;
+  int mMaximizerGoalWordSpan = 0;
+  int mMinimizerGoalWordSpan = 0;
+  BitBoard mMaximizerGoalStartCells;
+  BitBoard mMinimizerGoalStartCells;
+
 public:
   std::vector<char> mGrid;
   const WordDictionary& mDictionary;
@@ -352,6 +375,8 @@ public:
         }
       }
     }
+
+    initializeWordCellMasks();
   }
 
   char getGridChar(int y, int x) const { return mGrid[y * kBoardWidth + x]; }
@@ -368,7 +393,7 @@ public:
     return mLegalWordFactory.getLegalWordFromRenumberedGoodness(goodness, isMaximizer);
   }
 
-  int getLegalWordsSize() { return mLegalWordFactory.getSize(); }
+  int getLegalWordsSize() const { return mLegalWordFactory.getSize(); }
 
   // Return the beginning and end of range of all LegalWordIds with this same word.
   std::pair<std::multimap<std::string, LegalWordId>::iterator, std::multimap<std::string, LegalWordId>::iterator> getLegalWordIds(const std::string& word) {
@@ -423,8 +448,61 @@ public:
 
   const CoordinateList& getBombs() const { return mBombs; }
   const CoordinateList& getMegabombs() const { return mMegabombs; }
+  const BitBoard& getBombCellMask() const { return mBombCellMask; }
+
+  // Cells covered by the word with this renumbered goodness.
+  const BitBoard& getWordCellMaskFromRenumberedGoodness(int goodness, bool isMaximizer) const {
+    return isMaximizer ? mMaximizerWordCellMasks[goodness] : mMinimizerWordCellMasks[goodness];
+  }
+
+  // Words that win for this side when played, by renumbered goodness
+  // (see mMaximizerGoalWordBits), how many 64-bit words of that bitset
+  // hold any of them, and the cells they start from.
+  const InlineBitset& getGoalWordBits(bool isMaximizer) const {
+    return isMaximizer ? mMaximizerGoalWordBits : mMinimizerGoalWordBits;
+  }
+  int getGoalWordSpan(bool isMaximizer) const {
+    return isMaximizer ? mMaximizerGoalWordSpan : mMinimizerGoalWordSpan;
+  }
+  const BitBoard& getGoalStartCells(bool isMaximizer) const {
+    return isMaximizer ? mMaximizerGoalStartCells : mMinimizerGoalStartCells;
+  }
 
 private:
+  void initializeWordCellMasks() {
+    const int size = mLegalWordFactory.getSize();
+    mMaximizerWordCellMasks.resize(size);
+    mMinimizerWordCellMasks.resize(size);
+    mMaximizerGoalWordBits = InlineBitset(size);
+    mMinimizerGoalWordBits = InlineBitset(size);
+    for (LegalWordId legalWordId = 0; legalWordId < size; ++legalWordId) {
+      const LegalWord& legalWord = mLegalWordFactory.getWord(legalWordId);
+      const auto& start = legalWord.mWordSequence.front();
+      BitBoard mask;
+      for (const auto& cell : legalWord.mWordSequence) {
+        mask.set(cell.first * kBoardWidth + cell.second);
+        if (cell.first == kBoardHeight - 1) {
+          mMaximizerGoalWordBits.set(legalWord.mRenumberedMaximizerGoodness, true);
+          mMaximizerGoalWordSpan = std::max(mMaximizerGoalWordSpan, (legalWord.mRenumberedMaximizerGoodness >> 6) + 1);
+          mMaximizerGoalStartCells.set(start.first * kBoardWidth + start.second);
+        }
+        if (cell.first == 0) {
+          mMinimizerGoalWordBits.set(legalWord.mRenumberedMinimizerGoodness, true);
+          mMinimizerGoalWordSpan = std::max(mMinimizerGoalWordSpan, (legalWord.mRenumberedMinimizerGoodness >> 6) + 1);
+          mMinimizerGoalStartCells.set(start.first * kBoardWidth + start.second);
+        }
+      }
+      mMaximizerWordCellMasks[legalWord.mRenumberedMaximizerGoodness] = mask;
+      mMinimizerWordCellMasks[legalWord.mRenumberedMinimizerGoodness] = mask;
+    }
+    for (const auto& cell : mBombs) {
+      mBombCellMask.set(cell.first * kBoardWidth + cell.second);
+    }
+    for (const auto& cell : mMegabombs) {
+      mBombCellMask.set(cell.first * kBoardWidth + cell.second);
+    }
+  }
+
   void initializeSquareWordCounts() {
     for (int y = 0; y < kBoardHeight; y++) {
       for (int x = 0; x < kBoardWidth; x++) {
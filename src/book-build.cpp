@@ -0,0 +1,238 @@
+// book-build.cpp — Builds an opening book for one board (see opening-book.h).
+//
+// Searches the opening tree breadth first, up to --plies. A book serves one
+// side (--side): every position with that side to move gets a long
+// multi-PV search, and its best --width moves go into the book and are
+// expanded. The other side's moves are not the engine's to choose, so at
+// its positions every legal reply (or the --reply-width best by static
+// goodness) is expanded without a search. One engine serves the whole
+// build, so its TT carries over between the overlapping subtrees.
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "board.h"
+#include "easylogging++.h"
+#include "word-dictionary.h"
+#include "wordescape.cpp"
+#include "parallel-search.h"
+#include "opening-book.h"
+
+INITIALIZE_EASYLOGGINGPP
+
+namespace {
+
+struct BookOptions {
+  std::string dictionaryPath = "twl06_with_wordbase_additions.txt";
+  std::string boardText;
+  std::string outPath;
+  int plies = 4;
+  int width = 3;
+  char side = PLAYER_2;  // the side the book plays; the web UI's engine is Player 2
+  int replyWidth = 0;    // opponent replies expanded per position; 0 = all
+  double seconds = 10.0;
+  int maxDepth = MAX_DEPTH;
+  int maxMoves = 200;
+  int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  int ttBits = 22;
+};
+
+void printUsage(const char* argv0) {
+  std::cout
+    << "Usage: " << argv0 << " [dictionary-path] --board <text> --out <path> [options]\n"
+    << "The board text must be exactly what wordbase-server will be sent.\n"
+    << "Options:\n"
+    << "  --plies <N>        Book depth in plies from the start position (default 4)\n"
+    << "  --side <1|2>       Player the book plays (default 2)\n"
+    << "  --width <K>        Moves stored and expanded per book-side position (default 3)\n"
+    << "  --reply-width <K>  Opponent replies expanded per position, best by static\n"
+    << "                     goodness (default 0: every legal reply)\n"
+    << "  --seconds <value>  Search time per position (default 10)\n"
+    << "  --max-depth <N>    Max iterative deepening depth per position (default: no limit)\n"
+    << "  --max-moves <N>    Max legal moves searched per position (default 200)\n"
+    << "  --threads <N>      Lazy SMP search threads (default: all cores)\n"
+    << "  --tt-bits <N>      TT size = 2^N entries (default 22)\n"
+    ;
+}
+
+BookOptions parseArgs(int argc, char** argv) {
+  BookOptions options;
+  int index = 1;
+
+  if (index < argc && std::string(argv[index]).rfind("--", 0) != 0) {
+    options.dictionaryPath = argv[index++];
+  }
+
+  while (index < argc) {
+    std::string arg = argv[index++];
+    if (arg == "--board" && index < argc) {
+      options.boardText = argv[index++];
+    } else if (arg == "--out" && index < argc) {
+      options.outPath = argv[index++];
+    } else if (arg == "--plies" && index < argc) {
+      options.plies = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--side" && index < argc) {
+      const int side = std::stoi(argv[index++], nullptr, 0);
+      if (side != 1 && side != 2) {
+        throw std::invalid_argument("--side must be 1 or 2");
+      }
+      options.side = (side == 1) ? PLAYER_1 : PLAYER_2;
+    } else if (arg == "--width" && index < argc) {
+      options.width = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--reply-width" && index < argc) {
+      options.replyWidth = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--seconds" && index < argc) {
+      options.seconds = std::stod(argv[index++], nullptr);
+    } else if (arg == "--max-depth" && index < argc) {
+      options.maxDepth = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--max-moves" && index < argc) {
+      options.maxMoves = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--threads" && index < argc) {
+      options.threads = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--tt-bits" && index < argc) {
+      options.ttBits = std::stoi(argv[index++], nullptr, 0);
+    } else {
+      printUsage(argv[0]);
+      throw std::invalid_argument("Unknown or incomplete argument: " + arg);
+    }
+  }
+
+  if (options.boardText.empty()) {
+    printUsage(argv[0]);
+    throw std::invalid_argument("--board is required");
+  }
+  if (options.outPath.empty()) {
+    printUsage(argv[0]);
+    throw std::invalid_argument("--out is required");
+  }
+  if (options.plies < 1) {
+    throw std::invalid_argument("--plies must be >= 1");
+  }
+  if (options.width < 1) {
+    throw std::invalid_argument("--width must be >= 1");
+  }
+  if (options.replyWidth < 0) {
+    throw std::invalid_argument("--reply-width must be >= 0");
+  }
+  if (options.seconds <= 0.0) {
+    throw std::invalid_argument("--seconds must be positive");
+  }
+  if (options.threads < 1) {
+    throw std::invalid_argument("--threads must be >= 1");
+  }
+  if (options.ttBits < 10 || options.ttBits > 30) {
+    throw std::invalid_argument("--tt-bits must be in [10, 30]");
+  }
+  return options;
+}
+
+void buildBook(const BookOptions& options, BoardStatic& board) {
+  OpeningBook book(options.boardText, board);
+  LazySMPSearch<WordBaseState, WordBaseMove> search(
+      options.threads, options.seconds, options.maxMoves, options.maxDepth, true, options.ttBits);
+  search.setMultiPV(options.width);
+
+  std::deque<std::pair<WordBaseState, int>> frontier;
+  frontier.emplace_back(WordBaseState(&board, PLAYER_1), 0);
+  // Transpositions are searched once.
+  std::set<std::pair<uint64_t, uint64_t>> seen;
+  int positions = 0;
+  int replyPositions = 0;
+
+  while (!frontier.empty()) {
+    WordBaseState state = frontier.front().first;
+    const int ply = frontier.front().second;
+    frontier.pop_front();
+    if (state.is_terminal()
+        || !seen.insert({state.hash(), state.tt_verification_key()}).second) {
+      continue;
+    }
+
+    if (state.player_to_move != options.side) {
+      ++replyPositions;
+      if (ply + 1 < options.plies) {
+        const int replies = options.replyWidth > 0 ? options.replyWidth : INF;
+        for (const WordBaseMove& move : state.get_legal_moves(replies)) {
+          WordBaseState child(state);
+          child.make_move(move);
+          frontier.emplace_back(child, ply + 1);
+        }
+      }
+      continue;
+    }
+
+    WordBaseState searchState(state);
+    const WordBaseMove best = search.get_move(&searchState);
+    const auto& stats = search.getLastSearchStats();
+
+    // With --width 1 there are no root lines; the best move is the line.
+    std::vector<std::pair<WordBaseMove, int>> moves;
+    for (const auto& line : search.getRootLines()) {
+      moves.emplace_back(line.move, line.score);
+    }
+    if (moves.empty()) {
+      moves.emplace_back(best, stats.goodness);
+    }
+
+    std::cout << "position " << ++positions << " ply " << ply
+              << " depth " << stats.max_depth
+              << " nodes " << stats.nodes
+              << " seconds " << stats.elapsed_seconds;
+    for (size_t rank = 0; rank < moves.size(); rank++) {
+      const WordBaseMove& move = moves[rank].first;
+      book.add(state, move, moves[rank].second, stats.max_depth, static_cast<int>(rank));
+      std::cout << (rank == 0 ? " moves " : " ")
+                << board.getLegalWord(move.mLegalWordId).mWord << ":" << moves[rank].second;
+      if (ply + 1 < options.plies) {
+        WordBaseState child(state);
+        child.make_move(move);
+        frontier.emplace_back(child, ply + 1);
+      }
+    }
+    std::cout << std::endl;
+  }
+
+  book.save(options.outPath);
+  std::cout << "book positions " << positions << " entries " << book.size()
+            << " reply positions " << replyPositions
+            << " path " << options.outPath << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  START_EASYLOGGINGPP(argc, argv);
+
+  try {
+    el::Configurations loggingConfig;
+    loggingConfig.setToDefault();
+    loggingConfig.setGlobally(el::ConfigurationType::ToFile, "false");
+    loggingConfig.set(el::Level::Debug, el::ConfigurationType::Enabled, "false");
+    loggingConfig.set(el::Level::Verbose, el::ConfigurationType::Enabled, "false");
+    loggingConfig.set(el::Level::Trace, el::ConfigurationType::Enabled, "false");
+    el::Loggers::reconfigureAllLoggers(loggingConfig);
+
+    BookOptions options = parseArgs(argc, argv);
+
+    std::ifstream input(options.dictionaryPath);
+    if (!input.is_open()) {
+      throw std::runtime_error("Could not open dictionary file: \"" + options.dictionaryPath + "\"");
+    }
+
+    WordDictionary dictionary(input);
+    BoardStatic board(options.boardText, dictionary);
+    buildBook(options, board);
+  } catch (const std::exception& error) {
+    std::cerr << error.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
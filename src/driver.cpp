@@ -239,6 +239,49 @@ static bool doOneCommand(const char* dictionaryPath, const std::string& command)
       WordBaseState state(*gState);
       state.make_move(move);
       std::cout << state << std::endl;
+    } else if (tokens[0].compare("mpv") == 0) {
+      // Analyse the best few moves, each with an exact score and the line
+      // the search expects to follow it.
+      //
+      // Usage:
+      //  mpv <number of lines> <seconds> <max depth to search>
+      int numLines = 3;
+      if (tokens.size() > 1) {
+        numLines = std::stoi(tokens[1], nullptr, 0);
+      }
+
+      double maxSeconds = 3;
+      if (tokens.size() > 2) {
+        maxSeconds = std::stod(tokens[2], nullptr);
+      }
+
+      int maxDepth = 20;
+      if (tokens.size() > 3) {
+        maxDepth = std::stoi(tokens[3], nullptr, 0);
+      }
+
+      Minimax<WordBaseState, WordBaseMove> miniMax(maxSeconds);
+      miniMax.setMaxDepth(maxDepth);
+      miniMax.setMultiPV(numLines);
+      miniMax.setTraceStream(nullptr);
+      WordBaseState state(*gState);
+      miniMax.get_move(&state);
+      const auto& stats = miniMax.getLastSearchStats();
+      std::cout << "depth: " << stats.max_depth << std::endl;
+      // With one line there are no root lines; the best move is the line.
+      auto lines = miniMax.getRootLines();
+      if (lines.empty() && stats.max_depth > 0) {
+        lines.push_back({stats.best_move, stats.goodness, stats.pv});
+      }
+      int rank = 1;
+      for (const auto& line : lines) {
+        std::cout << rank++ << ". " << gBoard->getLegalWord(line.move.mLegalWordId).mWord
+                  << " score: " << line.score << " pv:";
+        for (const auto& move : line.pv) {
+          std::cout << " " << gBoard->getLegalWord(move.mLegalWordId).mWord;
+        }
+        std::cout << std::endl;
+      }
     } else if (tokens[0].compare("smmc") == 0) {
       // Use a montecarlo search tree method to suggest a move
       //
@@ -1,7 +1,11 @@
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <unordered_set>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 
 #include "board.h"
 #include "easylogging++.h"
@@ -10,6 +14,7 @@
 
 #include "wordescape.cpp"
 #include "parallel-search.h"
+#include "opening-book.h"
 
 INITIALIZE_EASYLOGGINGPP
 
@@ -41,51 +46,51 @@ namespace {
     TestState(char playerToMove, int eval, int depthRemaining)
       : State<TestState, TestMove>(playerToMove), mEval(eval), mDepthRemaining(depthRemaining) {}
 
-    TestState clone() const override {
+    TestState clone() const {
       return *this;
     }
 
-    int get_goodness() const override {
+    int get_goodness() const {
       return mEval;
     }
 
-    std::vector<TestMove> get_legal_moves(int max_moves = INF) const override {
+    std::vector<TestMove> get_legal_moves(int max_moves = INF) const {
       if (mDepthRemaining == 0) {
         return {};
       }
       return {TestMove(1), TestMove(2)};
     }
 
-    char get_enemy(char player) const override {
+    char get_enemy(char player) const {
       return player == PLAYER_1 ? PLAYER_2 : PLAYER_1;
     }
 
-    bool is_terminal() const override {
+    bool is_terminal() const {
       return mDepthRemaining == 0;
     }
 
-    bool is_winner(char player) const override {
+    bool is_winner(char player) const {
       return false;
     }
 
-    void make_move(const TestMove& move) override {
+    void make_move(const TestMove& move) {
       player_to_move = get_enemy(player_to_move);
       mDepthRemaining -= 1;
       mEval = (move.mId == 1) ? 10 : -10;
     }
 
-    std::ostream& to_stream(std::ostream& os) const override {
+    std::ostream& to_stream(std::ostream& os) const {
       os << "eval=" << mEval << " depth=" << mDepthRemaining;
       return os;
     }
 
-    bool operator==(const TestState& other) const override {
+    bool operator==(const TestState& other) const {
       return player_to_move == other.player_to_move
         && mEval == other.mEval
         && mDepthRemaining == other.mDepthRemaining;
     }
 
-    size_t hash() const override {
+    size_t hash() const {
       size_t seed = std::hash<int>()(mEval);
       boost::hash_combine(seed, mDepthRemaining);
       boost::hash_combine(seed, player_to_move);
@@ -106,45 +111,45 @@ namespace {
         mHashValue(hashValue),
         mVerificationKey(verificationKey) {}
 
-    CollidingState clone() const override {
+    CollidingState clone() const {
       return *this;
     }
 
-    int get_goodness() const override {
+    int get_goodness() const {
       return mEval;
     }
 
-    std::vector<TestMove> get_legal_moves(int max_moves = INF) const override {
+    std::vector<TestMove> get_legal_moves(int max_moves = INF) const {
       if (mDepthRemaining == 0) {
         return {};
       }
       return {TestMove(1), TestMove(2)};
     }
 
-    char get_enemy(char player) const override {
+    char get_enemy(char player) const {
       return player == PLAYER_1 ? PLAYER_2 : PLAYER_1;
     }
 
-    bool is_terminal() const override {
+    bool is_terminal() const {
       return mDepthRemaining == 0;
     }
 
-    bool is_winner(char player) const override {
+    bool is_winner(char player) const {
       return false;
     }
 
-    void make_move(const TestMove& move) override {
+    void make_move(const TestMove& move) {
       player_to_move = get_enemy(player_to_move);
       mDepthRemaining -= 1;
       mEval = (move.mId == 1) ? 10 : -10;
     }
 
-    std::ostream& to_stream(std::ostream& os) const override {
+    std::ostream& to_stream(std::ostream& os) const {
       os << "eval=" << mEval << " depth=" << mDepthRemaining;
       return os;
     }
 
-    bool operator==(const CollidingState& other) const override {
+    bool operator==(const CollidingState& other) const {
       return player_to_move == other.player_to_move
         && mEval == other.mEval
         && mDepthRemaining == other.mDepthRemaining
@@ -152,11 +157,11 @@ namespace {
         && mVerificationKey == other.mVerificationKey;
     }
 
-    size_t hash() const override {
+    size_t hash() const {
       return mHashValue;
     }
 
-    uint64_t tt_verification_key() const override {
+    uint64_t tt_verification_key() const {
       return mVerificationKey;
     }
   };
@@ -319,6 +324,37 @@ namespace {
     EXPECT_LE(moves.size(), 2);
   }
 
+  TEST_F(FooTest, CountLegalMovesMatchesGeneratedMovesForBothSides) {
+    std::istringstream dictionaryFileContents(
+      std::string("gram\n")
+      + "glam\n"
+      + "glamor\n"
+      + "glamorizes\n"
+      + "glass\n"
+      + "soap\n"
+      + "soaps\n"
+      + "copy\n"
+      + "cops\n");
+    WordDictionary wd(dictionaryFileContents);
+    BoardStatic board(kReadmeBoard, wd);
+    WordBaseState state(&board, PLAYER_1);
+    WordBaseState opponentView(&board, PLAYER_2);
+
+    EXPECT_EQ(state.count_legal_moves(PLAYER_1), static_cast<int>(state.get_legal_moves(INF).size()));
+    EXPECT_EQ(state.count_legal_moves(PLAYER_2), static_cast<int>(opponentView.get_legal_moves(INF).size()));
+
+    // Played words (and their equivalents) drop out of both sides' counts.
+    std::vector<WordBaseMove> moves = state.get_legal_moves(INF, "glamorizes");
+    ASSERT_EQ(moves.size(), 1);
+    state.make_move(moves[0]);
+    state.addAlreadyPlayed("soap");
+    WordBaseState mover(state);
+    mover.setPlayerToMove(PLAYER_1);
+
+    EXPECT_EQ(state.count_legal_moves(PLAYER_2), static_cast<int>(state.get_legal_moves(INF).size()));
+    EXPECT_EQ(state.count_legal_moves(PLAYER_1), static_cast<int>(mover.get_legal_moves(INF).size()));
+  }
+
   TEST_F(FooTest, MinimaxEvaluatesCurrentLeafState) {
     TestState state(PLAYER_1, 0, 1);
     Minimax<TestState, TestMove> minimax(1.0, INF);
@@ -380,6 +416,33 @@ namespace {
     EXPECT_EQ(state.tt_verification_key(), state.computeVerificationKeyFromState());
   }
 
+  TEST_F(FooTest, LookupTablesAreBuiltAtCompileTime) {
+    // These only compile if the tables are constant-initialized.
+    static_assert(WordBaseState::sGoodnessTable[0][PLAYER_1] == 1, "row 0 maximizer weight");
+    static_assert(WordBaseState::sGoodnessTable[12][PLAYER_2] == -1, "row 12 minimizer weight");
+    static_assert(sRow0Mask.test(9) && !sRow0Mask.test(10), "row 0 mask");
+    static_assert(!not_col_0.test(10) && not_col_9.test(10), "column masks");
+    static_assert(sBombBlastMasks[11].test(1) && !sBombBlastMasks[11].test(0), "bomb blast is orthogonal");
+    static_assert(sNeighborMasks[11].test(0), "neighbor mask includes diagonals");
+
+    for (int pos = 0; pos < kGridCells; pos++) {
+      for (int owner = 0; owner < WordBaseState::kMaxOwner; owner++) {
+        EXPECT_EQ(WordBaseState::sCellHashTable[pos][owner],
+                  WordBaseState::mixHashToken((static_cast<uint64_t>(pos) << 8) ^ owner ^ 0x3141592653589793ULL));
+      }
+    }
+
+    // Corner cells have 3 neighbors (2 orthogonal), interior cells have 8 (4).
+    auto popcount = [](const BitBoard& b) {
+      return __builtin_popcountll(b.w[0]) + __builtin_popcountll(b.w[1]) + __builtin_popcountll(b.w[2]);
+    };
+    EXPECT_EQ(popcount(sNeighborMasks[0]), 3);
+    EXPECT_EQ(popcount(sBombBlastMasks[0]), 2);
+    EXPECT_EQ(popcount(sNeighborMasks[kGridCells - 1]), 3);
+    EXPECT_EQ(popcount(sNeighborMasks[5 * kBoardWidth + 5]), 8);
+    EXPECT_EQ(popcount(sBombBlastMasks[5 * kBoardWidth + 5]), 4);
+  }
+
   TEST_F(FooTest, MinimaxRejectsTranspositionEntriesWithMismatchedVerificationKey) {
     Minimax<CollidingState, TestMove> minimax(1.0, INF);
     minimax.setMaxDepth(1);
@@ -398,6 +461,99 @@ namespace {
     EXPECT_GE(minimax.getLastSearchStats().leafs, 2);  // PVS re-search may add leafs
   }
 
+  TEST_F(FooTest, WideTTEntryKeepsWhatThePackedEntryClips) {
+    TTEntry<TestMove> packed(TestMove(8000), 0x123456789ABCDEF0ULL, 40, 5000, TTEntryType::LOWER_BOUND);
+    EXPECT_NE(packed.get_depth(), 40);
+    EXPECT_NE(packed.get_value(), 5000);
+
+    WideTTEntry<TestMove> wide(TestMove(8000), 0x123456789ABCDEF0ULL, 40, 5000, TTEntryType::LOWER_BOUND);
+    EXPECT_EQ(sizeof(wide), 16u);
+    EXPECT_EQ(wide.get_move().mLegalWordId, 8000);
+    EXPECT_EQ(wide.get_depth(), 40);
+    EXPECT_EQ(wide.get_value(), 5000);
+    EXPECT_EQ(wide.get_value_type(), TTEntryType::LOWER_BOUND);
+    EXPECT_TRUE(wide.matches(0x123456789ABCDEF0ULL));
+    EXPECT_FALSE(wide.matches(0x000000009ABCDEF0ULL)) << "all 64 key bits are checked";
+
+    // A torn write: one position's check word next to another's data.
+    WideTTEntry<TestMove> other(TestMove(3), 0x0FEDCBA987654321ULL, 2, -7, TTEntryType::EXACT_VALUE);
+    WideTTEntry<TestMove> torn = wide;
+    torn.data = other.data;
+    EXPECT_FALSE(torn.matches(0x123456789ABCDEF0ULL));
+    EXPECT_FALSE(torn.matches(0x0FEDCBA987654321ULL));
+    wide.set_generation(5);
+    EXPECT_EQ(wide.get_generation(), 5);
+    EXPECT_TRUE(wide.matches(0x123456789ABCDEF0ULL));
+
+    TranspositionTable<TestMove, WideTTEntry<TestMove>> tt(3);
+    ASSERT_EQ(tt.capacity(), 4u);
+    tt.new_search();
+    tt.store(7, 0x123456789ABCDEF0ULL, wide);
+    WideTTEntry<TestMove> found;
+    ASSERT_TRUE(tt.probe(7, 0x123456789ABCDEF0ULL, found));
+    EXPECT_EQ(found.get_value(), 5000);
+    EXPECT_EQ(found.get_value_type(), TTEntryType::LOWER_BOUND);
+    EXPECT_FALSE(tt.probe(7, 0x000000009ABCDEF0ULL, found));
+  }
+
+  TEST_F(FooTest, TranspositionTableSizesInMegabytesAndKeepsEntriesAcrossMoves) {
+    using Table = TranspositionTable<TestMove>;
+    EXPECT_EQ(Table::size_bits_for_mb(1), 17u);
+    EXPECT_EQ(Table::size_bits_for_mb(64), 23u);
+    EXPECT_EQ(Table::size_bits_for_mb(100), 23u);  // rounds down to a power of two
+
+    // 4 MB is big enough to request huge pages; whatever backs it, it must
+    // start zeroed and be usable.
+    Table tt(Table::size_bits_for_mb(4));
+    EXPECT_EQ(tt.size_bytes(), 4u << 20);
+    EXPECT_EQ(tt.count_populated(), 0u);
+    tt.new_search();
+    tt.prefetch(0x1234);
+    tt.store(0x1234, 77, TTEntry<TestMove>(TestMove(5), 77, 3, 9, TTEntryType::EXACT_VALUE));
+
+    Table copied(tt);
+    Table moved(std::move(tt));
+    EXPECT_TRUE(tt.empty());
+    TTEntry<TestMove> entry;
+    ASSERT_TRUE(copied.probe(0x1234, 77, entry));
+    EXPECT_EQ(entry.get_value(), 9);
+    ASSERT_TRUE(moved.probe(0x1234, 77, entry));
+    EXPECT_EQ(entry.get_move().mLegalWordId, 5);
+
+    Table unpaged(12, false);
+    EXPECT_EQ(unpaged.page_mode(), TTPageMode::Default);
+  }
+
+  TEST_F(FooTest, BucketedTranspositionTableKeepsDeepEntriesAndAgesThemOut) {
+    // 3 size bits -> a single bucket, so every store competes for 7 slots.
+    TranspositionTable<TestMove> tt(3);
+    ASSERT_EQ(tt.capacity(), 7u);
+    tt.new_search();
+
+    const uint64_t deepKey = 0xDEADBEEF;
+    tt.store(0, deepKey, TTEntry<TestMove>(TestMove(1), deepKey, 12, 50, TTEntryType::EXACT_VALUE));
+    for (uint64_t k = 1; k <= 40; k++) {
+      tt.store(k, k, TTEntry<TestMove>(TestMove(2), k, 1, 0, TTEntryType::LOWER_BOUND));
+    }
+    TTEntry<TestMove> entry;
+    ASSERT_TRUE(tt.probe(0, deepKey, entry)) << "shallow stores must not evict a deep entry";
+    EXPECT_EQ(entry.get_depth(), 12);
+    EXPECT_EQ(entry.get_value(), 50);
+    EXPECT_TRUE(tt.probe(40, 40, entry)) << "latest shallow entry should be stored";
+
+    // A shallower bound for the same position does not clobber it either.
+    tt.store(0, deepKey, TTEntry<TestMove>(TestMove(3), deepKey, 2, -7, TTEntryType::UPPER_BOUND));
+    ASSERT_TRUE(tt.probe(0, deepKey, entry));
+    EXPECT_EQ(entry.get_depth(), 12);
+
+    // After enough searches, the stale deep entry loses to fresh shallow ones.
+    for (int i = 0; i < 4; i++) tt.new_search();
+    for (uint64_t k = 100; k < 107; k++) {
+      tt.store(k, k, TTEntry<TestMove>(TestMove(2), k, 1, 0, TTEntryType::LOWER_BOUND));
+    }
+    EXPECT_FALSE(tt.probe(0, deepKey, entry));
+  }
+
   TEST_F(FooTest, EquivalentLegalWordIdsMatchWordLookupRange) {
     std::istringstream dictionaryFileContents(
       std::string("gram\n")
@@ -485,34 +641,221 @@ namespace {
     EXPECT_EQ(move.mLegalWordId, allMoves[0].mLegalWordId);
   }
 
+  // MovePicker yields the valid candidates first, then every other legal
+  // move once, in the order a stable sort by history would give.
+  TEST_F(ParallelSearchTest, MovePickerYieldsStagedHistoryOrder) {
+    std::vector<WordBaseMove> legal;
+    state->fill_legal_moves(legal, 200);
+    ASSERT_GE(legal.size(), 5u);  // past LAZY_PICKS, so the rest gets sorted
+    std::vector<int> history(board->getLegalWordsSize() + 1, 0);
+    for (size_t i = 0; i < legal.size(); i++) {
+      history[legal[i].mLegalWordId] = static_cast<int>(i % 3) * 10;  // ties on purpose
+    }
+    std::vector<WordBaseMove> expected = legal;
+    std::stable_sort(expected.begin(), expected.end(),
+      [&](const WordBaseMove& a, const WordBaseMove& b) {
+        return history[a.mLegalWordId] > history[b.mLegalWordId];
+      });
+    auto ids = [](const std::vector<WordBaseMove>& moves) {
+      std::vector<int> result;
+      for (const auto& move : moves) result.push_back(move.mLegalWordId);
+      return result;
+    };
+
+    // Interior node: an invalid candidate and a repeated one are dropped.
+    const WordBaseMove tt = legal.back();
+    const WordBaseMove killer = legal[1];
+    std::vector<WordBaseMove> buffer;
+    std::vector<uint64_t> keys;
+    MovePicker<WordBaseState, WordBaseMove> picker(state.get(), buffer, keys, 200, false, false,
+                                                   history.data(), static_cast<int>(history.size()), true);
+    picker.addCandidate(tt);
+    picker.addCandidate(WordBaseMove(board->getLegalWordsSize()));
+    picker.addCandidate(killer);
+    picker.addCandidate(tt);
+    std::vector<WordBaseMove> order;
+    WordBaseMove move;
+    while (picker.next(move)) order.push_back(move);
+    std::vector<WordBaseMove> want = {tt, killer};
+    for (const auto& m : expected) {
+      if (!(m == tt) && !(m == killer)) want.push_back(m);
+    }
+    EXPECT_EQ(ids(order), ids(want));
+    ASSERT_TRUE(picker.hasMoves());
+    EXPECT_EQ(picker.first().mLegalWordId, expected[0].mLegalWordId);
+
+    // Root: the list is given, the candidates move to its front, and the
+    // list is left in search order.
+    std::vector<WordBaseMove> root = legal;
+    MovePicker<WordBaseState, WordBaseMove> rootPicker(state.get(), root, keys, 200, true, true,
+                                                       history.data(), static_cast<int>(history.size()), true);
+    rootPicker.addCandidate(killer);
+    order.clear();
+    while (rootPicker.next(move)) order.push_back(move);
+    want = {killer};
+    for (const auto& m : legal) {
+      if (!(m == killer)) want.push_back(m);
+    }
+    std::stable_sort(want.begin() + 1, want.end(),
+      [&](const WordBaseMove& a, const WordBaseMove& b) {
+        return history[a.mLegalWordId] > history[b.mLegalWordId];
+      });
+    EXPECT_EQ(ids(order), ids(want));
+    EXPECT_EQ(ids(root), ids(want));
+  }
+
+  // Continuation-history tables are sized by the number of move ids and
+  // score each (earlier move, reply) pair on its own.
+  TEST_F(ParallelSearchTest, ContinuationHistoryScalesWithMoveIds) {
+    EXPECT_EQ(state->move_id_count(), board->getLegalWordsSize());
+
+    ContinuationHistory history;
+    history.resize(10000);
+    EXPECT_EQ(history.size_bytes(), (size_t{1} << 17) * sizeof(int16_t));
+
+    history.update(7, 11, 100);
+    history.update(7, 12, -100);
+    EXPECT_EQ(history.get(7, 11), 100);
+    EXPECT_EQ(history.get(7, 12), -100);
+    for (int i = 0; i < 1000; i++) {
+      history.update(7, 11, 400);
+    }
+    EXPECT_LE(history.get(7, 11), ContinuationHistory::MAX_SCORE);
+    history.age();
+    EXPECT_LE(history.get(7, 11), ContinuationHistory::MAX_SCORE / 8);
+
+    // Same size: kept. A different one: cleared.
+    history.resize(10000);
+    EXPECT_EQ(history.get(7, 12), -100 / 8);
+    history.resize(40000);
+    EXPECT_EQ(history.size_bytes(), (size_t{1} << 19) * sizeof(int16_t));
+    EXPECT_EQ(history.get(7, 12), 0);
+  }
+
+  // The stats' principal variation starts with the move played and is a
+  // legal line no longer than the search depth.
+  TEST_F(ParallelSearchTest, SearchStatsCarryPrincipalVariation) {
+    Minimax<WordBaseState, WordBaseMove> engine(10.0, 200);
+    engine.setMaxDepth(4);
+    engine.setTraceStream(nullptr);
+    WordBaseState searchState(*state);
+    WordBaseMove move = engine.get_move(&searchState);
+
+    const auto& pv = engine.getLastSearchStats().pv;
+    ASSERT_FALSE(pv.empty());
+    EXPECT_LE(pv.size(), 4u);
+    EXPECT_EQ(pv[0].mLegalWordId, move.mLegalWordId);
+    WordBaseState walk(*state);
+    for (const auto& pvMove : pv) {
+      ASSERT_TRUE(walk.isValidMove(pvMove));
+      walk.make_move(pvMove);
+    }
+
+    engine.setTrackPV(false);
+    WordBaseState again(*state);
+    engine.get_move(&again);
+    EXPECT_TRUE(engine.getLastSearchStats().pv.empty());
+  }
+
+  // The width schedule tapers with ply, widens with depth, keeps PV nodes
+  // apart from the rest, and its root cap limits the moves searched.
+  TEST_F(ParallelSearchTest, WidthScheduleCapsMovesPerNode) {
+    MinimaxWidthConfig width;
+    width.enabled = true;
+    width.root_moves = 1;
+    width.pv_moves = 150;
+    width.cut_moves = 100;
+    width.taper_per_ply = 20;
+    width.depth_bonus = 5;
+    width.min_moves = 30;
+    EXPECT_EQ(width.cap(0, 6, true), 1);
+    EXPECT_EQ(width.cap(1, 1, true), 150);
+    EXPECT_EQ(width.cap(1, 1, false), 100);
+    EXPECT_EQ(width.cap(3, 1, false), 60);
+    EXPECT_EQ(width.cap(3, 3, false), 70);
+    EXPECT_EQ(width.cap(10, 1, false), 30);
+
+    std::vector<WordBaseMove> best;
+    state->fill_legal_moves(best, 1);
+    ASSERT_EQ(best.size(), 1u);
+    Minimax<WordBaseState, WordBaseMove> engine(10.0, 200);
+    engine.setMaxDepth(3);
+    engine.setTraceStream(nullptr);
+    engine.setWidthConfig(width);
+    WordBaseState searchState(*state);
+    EXPECT_EQ(engine.get_move(&searchState).mLegalWordId, best[0].mLegalWordId);
+  }
+
+  // A fixed-policy engine searches the same tree as the runtime Minimax
+  // configured the same way.
+  TEST_F(ParallelSearchTest, StaticPolicyMatchesRuntimeMinimax) {
+    Minimax<WordBaseState, WordBaseMove> runtime(10.0, 200);
+    MinimaxEngine<WordBaseState, WordBaseMove, TTEntry<WordBaseMove>, LocalMinimaxPolicy> fixed(10.0, 200);
+    runtime.setMaxDepth(3);
+    runtime.setTraceStream(nullptr);
+    fixed.setMaxDepth(3);
+
+    WordBaseState runtimeState(*state);
+    WordBaseState fixedState(*state);
+    WordBaseMove runtimeMove = runtime.get_move(&runtimeState);
+    WordBaseMove fixedMove = fixed.get_move(&fixedState);
+    EXPECT_EQ(fixedMove.mLegalWordId, runtimeMove.mLegalWordId);
+    EXPECT_EQ(fixed.getLastSearchStats().goodness, runtime.getLastSearchStats().goodness);
+    EXPECT_EQ(fixed.getLastSearchStats().nodes, runtime.getLastSearchStats().nodes);
+  }
+
+  // States dispatch statically; StateAdapter gives the same game through
+  // AnyState's virtual interface.
+  TEST_F(ParallelSearchTest, StateAdapterForwardsToConcreteState) {
+    static_assert(!std::is_polymorphic<WordBaseState>::value, "State must not add a vtable");
+    std::unique_ptr<AnyState<WordBaseMove>> any =
+      std::make_unique<StateAdapter<WordBaseState, WordBaseMove>>(*state);
+    WordBaseState direct(*state);
+    for (int ply = 0; ply < 4 && !direct.is_terminal(); ply++) {
+      const auto moves = any->get_legal_moves();
+      ASSERT_EQ(moves.size(), direct.get_legal_moves().size());
+      ASSERT_FALSE(moves.empty());
+      EXPECT_TRUE(any->isValidMove(moves[0]));
+      auto before = any->clone();
+      any->make_move(moves[0]);
+      direct.make_move(moves[0]);
+      EXPECT_NE(before->hash(), any->hash());
+      EXPECT_EQ(any->hash(), direct.hash());
+      EXPECT_EQ(any->tt_verification_key(), direct.tt_verification_key());
+      EXPECT_EQ(any->get_player_to_move(), direct.player_to_move);
+      EXPECT_EQ(any->get_goodness(), direct.get_goodness());
+      EXPECT_EQ(any->is_terminal(), direct.is_terminal());
+    }
+    std::stringstream viaAny, viaState;
+    viaAny << *any;
+    viaState << direct;
+    EXPECT_EQ(viaAny.str(), viaState.str());
+  }
+
   // Shared TT: two Minimax instances sharing a TT should produce TT hits.
   TEST_F(ParallelSearchTest, SharedTTProducesTTHits) {
-    constexpr size_t TT_SIZE = Minimax<WordBaseState, WordBaseMove>::TT_SIZE;
-    std::vector<TTEntry<WordBaseMove>> sharedTT(TT_SIZE);
+    TranspositionTable<WordBaseMove> sharedTT(Minimax<WordBaseState, WordBaseMove>::DEFAULT_TT_SIZE_BITS);
+    sharedTT.new_search();
 
     // First engine populates the TT.
     {
       Minimax<WordBaseState, WordBaseMove> engine1(1.0, 200);
       engine1.setMaxDepth(3);
       engine1.setTraceStream(nullptr);
-      engine1.setSharedTT(sharedTT.data());
+      engine1.setSharedTT(&sharedTT);
       WordBaseState s1(*state);
       engine1.get_move(&s1);
     }
 
     // Count non-empty TT entries.
-    int populated = 0;
-    for (size_t i = 0; i < TT_SIZE; i++) {
-      if (sharedTT[i].data != 0) populated++;
-    }
-    EXPECT_GT(populated, 0) << "First engine should have populated the shared TT";
+    EXPECT_GT(sharedTT.count_populated(), 0u) << "First engine should have populated the shared TT";
 
     // Second engine should hit TT entries from the first.
     {
       Minimax<WordBaseState, WordBaseMove> engine2(1.0, 200);
       engine2.setMaxDepth(3);
       engine2.setTraceStream(nullptr);
-      engine2.setSharedTT(sharedTT.data());
+      engine2.setSharedTT(&sharedTT);
       WordBaseState s2(*state);
       engine2.get_move(&s2);
       EXPECT_GT(engine2.getLastSearchStats().tt_hits, 0)
@@ -520,6 +863,460 @@ namespace {
     }
   }
 
+  // Aspiration windows only change how a depth is searched, not its score:
+  // a narrow window that fails must be re-searched until the score is exact.
+  TEST_F(ParallelSearchTest, AspirationWindowsPreserveFixedDepthScore) {
+    Minimax<WordBaseState, WordBaseMove> fullWindow(10.0, 200);
+    fullWindow.setMaxDepth(4);
+    fullWindow.setTraceStream(nullptr);
+    Minimax<WordBaseState, WordBaseMove>::AspirationConfig disabled;
+    disabled.enabled = false;
+    fullWindow.setAspirationConfig(disabled);
+    WordBaseState s0(*state);
+    fullWindow.get_move(&s0);
+
+    // A 1-point window forces re-searches at every aspirated depth.
+    Minimax<WordBaseState, WordBaseMove> aspirated(10.0, 200);
+    aspirated.setMaxDepth(4);
+    aspirated.setTraceStream(nullptr);
+    Minimax<WordBaseState, WordBaseMove>::AspirationConfig narrow;
+    narrow.initial_width = 1;
+    narrow.min_depth = 2;
+    aspirated.setAspirationConfig(narrow);
+    WordBaseState s1(*state);
+    aspirated.get_move(&s1);
+
+    EXPECT_EQ(aspirated.getLastSearchStats().max_depth, 4);
+    EXPECT_EQ(aspirated.getLastSearchStats().goodness, fullWindow.getLastSearchStats().goodness);
+    EXPECT_GT(aspirated.getLastSearchStats().aspiration_researches(), 0);
+    EXPECT_EQ(fullWindow.getLastSearchStats().aspiration_researches(), 0);
+  }
+
+  // A pass flips only the side to move and undoes exactly; null-move
+  // pruning and ProbCut fire at depth and stay silent when switched off.
+  TEST_F(ParallelSearchTest, SelectivePruningCutsSubtreesAndCanBeDisabled) {
+    WordBaseState passed(*state);
+    ASSERT_TRUE(passed.make_null_move());
+    EXPECT_EQ(passed.player_to_move, PLAYER_2);
+    EXPECT_NE(passed.hash(), state->hash());
+    passed.undo_null_move();
+    EXPECT_TRUE(passed == *state);
+    EXPECT_EQ(passed.hash(), state->hash());
+    EXPECT_EQ(passed.tt_verification_key(), state->tt_verification_key());
+
+    Minimax<WordBaseState, WordBaseMove> plain(10.0, 200);
+    plain.setMaxDepth(6);
+    plain.setTraceStream(nullptr);
+    Minimax<WordBaseState, WordBaseMove>::SelectiveConfig off;
+    off.null_move = false;
+    off.probcut = false;
+    plain.setSelectiveConfig(off);
+    WordBaseState s0(*state);
+    EXPECT_GE(plain.get_move(&s0).mLegalWordId, 0);
+
+    // The small test dictionary keeps the tree shallow; loosen the
+    // thresholds so both stages get a chance to fire.
+    Minimax<WordBaseState, WordBaseMove> selective(10.0, 200);
+    selective.setMaxDepth(6);
+    selective.setTraceStream(nullptr);
+    Minimax<WordBaseState, WordBaseMove>::SelectiveConfig loose;
+    loose.null_move_min_depth = 2;
+    loose.probcut_min_depth = 3;
+    loose.probcut_reduction = 2;
+    loose.probcut_margin = 20;
+    selective.setSelectiveConfig(loose);
+    WordBaseState s1(*state);
+    EXPECT_GE(selective.get_move(&s1).mLegalWordId, 0);
+
+    EXPECT_EQ(plain.getLastSearchStats().null_move_cuts, 0);
+    EXPECT_EQ(plain.getLastSearchStats().probcut_cuts, 0);
+    EXPECT_GT(selective.getLastSearchStats().null_move_cuts, 0);
+    EXPECT_GT(selective.getLastSearchStats().probcut_cuts, 0);
+    EXPECT_EQ(selective.getLastSearchStats().max_depth, 6);
+  }
+
+  // The soft deadline only gates starting a new depth; the stats say why
+  // deepening stopped.
+  TEST_F(ParallelSearchTest, TimeManagerStopsDeepeningAtSoftDeadline) {
+    Minimax<WordBaseState, WordBaseMove> engine(10.0, 200);
+    engine.setMaxDepth(6);
+    engine.setTraceStream(nullptr);
+    WordBaseState s0(*state);
+    engine.get_move(&s0);
+    EXPECT_EQ(engine.getLastSearchStats().max_depth, 6);
+    EXPECT_EQ(engine.getLastSearchStats().stop_reason, SearchStopReason::DepthLimit);
+
+    engine.setSoftSeconds(1e-9);
+    WordBaseState s1(*state);
+    EXPECT_GE(engine.get_move(&s1).mLegalWordId, 0);
+    EXPECT_EQ(engine.getLastSearchStats().max_depth, 1);
+    EXPECT_EQ(engine.getLastSearchStats().stop_reason, SearchStopReason::SoftDeadline);
+
+    Minimax<WordBaseState, WordBaseMove>::TimeConfig off;
+    off.enabled = false;
+    engine.setTimeConfig(off);
+    WordBaseState s2(*state);
+    engine.get_move(&s2);
+    EXPECT_EQ(engine.getLastSearchStats().max_depth, 6);
+  }
+
+  // Multi-PV lines are distinct root moves, best first, each scored like a
+  // search of that root move alone and followed by a playable PV.
+  TEST_F(ParallelSearchTest, MultiPVReportsExactScoresForTopMoves) {
+    auto allMoves = state->get_legal_moves(200);
+    ASSERT_GE(allMoves.size(), 3u);
+
+    Minimax<WordBaseState, WordBaseMove> engine(10.0, 200);
+    engine.setMaxDepth(4);
+    engine.setTraceStream(nullptr);
+    engine.setMultiPV(3);
+    WordBaseState s0(*state);
+    WordBaseMove best = engine.get_move(&s0);
+    const auto& lines = engine.getRootLines();
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(engine.getLastSearchStats().max_depth, 4);
+    EXPECT_EQ(lines[0].move.mLegalWordId, best.mLegalWordId);
+    EXPECT_EQ(lines[0].score, engine.getLastSearchStats().goodness);
+
+    std::unordered_set<int> seen;
+    for (size_t i = 0; i < lines.size(); i++) {
+      EXPECT_TRUE(seen.insert(lines[i].move.mLegalWordId).second);
+      if (i > 0) {
+        EXPECT_LE(lines[i].score, lines[i - 1].score);
+      }
+
+      Minimax<WordBaseState, WordBaseMove> single(10.0, 200);
+      single.setMaxDepth(4);
+      single.setTraceStream(nullptr);
+      single.setRootMoves({lines[i].move});
+      WordBaseState s1(*state);
+      single.get_move(&s1);
+      EXPECT_EQ(lines[i].score, single.getLastSearchStats().goodness) << "line " << i;
+
+      ASSERT_GE(lines[i].pv.size(), 1u);
+      EXPECT_LE(lines[i].pv.size(), 4u);
+      EXPECT_EQ(lines[i].pv[0].mLegalWordId, lines[i].move.mLegalWordId);
+      WordBaseState replay(*state);
+      for (const auto& move : lines[i].pv) {
+        ASSERT_TRUE(replay.isValidMove(move));
+        replay.make_move(move);
+      }
+    }
+
+    // Parallel strategies report the lines of a full-width engine.
+    LazySMPSearch<WordBaseState, WordBaseMove> smp(2, 10.0, 200, 4);
+    smp.setMultiPV(3);
+    WordBaseState s2(*state);
+    smp.get_move(&s2);
+    EXPECT_EQ(smp.getRootLines().size(), 3u);
+  }
+
+  // Capture moves are the legal moves that touch an enemy cell or a live
+  // bomb; quiescence searches only those below the horizon.
+  TEST_F(ParallelSearchTest, QuiescenceSearchesOnlyCaptures) {
+    Minimax<WordBaseState, WordBaseMove> mover(10.0, 200);
+    mover.setMaxDepth(2);
+    mover.setTraceStream(nullptr);
+    WordBaseState s0(*state);
+    std::vector<WordBaseMove> captures;
+    for (int ply = 0; ply < 40 && !s0.is_terminal(); ply++) {
+      s0.fill_capture_moves(captures, INF);
+      if (!captures.empty()) {
+        break;
+      }
+      s0.make_move(mover.get_move(&s0));
+    }
+    ASSERT_FALSE(captures.empty());
+
+    std::unordered_set<int> captureIds;
+    for (const auto& move : captures) {
+      EXPECT_TRUE(s0.isValidMove(move));
+      EXPECT_TRUE(captureIds.insert(move.mLegalWordId).second);
+    }
+    const bool maximizer = (s0.player_to_move == PLAYER_1);
+    auto enemyBits = [maximizer](const WordBaseState& s) {
+      const BitBoard& bits = maximizer ? s.mPlayer2Bits : s.mPlayer1Bits;
+      return std::vector<uint64_t>(bits.w, bits.w + 3);
+    };
+    for (const auto& move : s0.get_legal_moves(INF)) {
+      if (captureIds.count(move.mLegalWordId)) {
+        continue;
+      }
+      WordBaseState quiet(s0);
+      quiet.make_move(move);
+      EXPECT_EQ(enemyBits(quiet), enemyBits(s0)) << "move " << move.mLegalWordId;
+    }
+    s0.fill_capture_moves(captures, 2);
+    EXPECT_LE(captures.size(), 2u);
+
+    // From the opening position, depth-2 leaves already have captures.
+    Minimax<WordBaseState, WordBaseMove> plain(10.0, 200);
+    plain.setMaxDepth(2);
+    plain.setTraceStream(nullptr);
+    WordBaseState s1(*state);
+    EXPECT_GE(plain.get_move(&s1).mLegalWordId, 0);
+    EXPECT_EQ(plain.getLastSearchStats().quiescence_nodes, 0);
+
+    Minimax<WordBaseState, WordBaseMove> engine(10.0, 200);
+    engine.setMaxDepth(2);
+    engine.setTraceStream(nullptr);
+    Minimax<WordBaseState, WordBaseMove>::QuiescenceConfig on;
+    on.enabled = true;
+    engine.setQuiescenceConfig(on);
+    WordBaseState s2(*state);
+    EXPECT_GE(engine.get_move(&s2).mLegalWordId, 0);
+    EXPECT_GT(engine.getLastSearchStats().quiescence_nodes, 0);
+    EXPECT_LT(engine.getLastSearchStats().quiescence_nodes, engine.getLastSearchStats().nodes);
+  }
+
+  // Brute-force references for the proof-number solver: the side to move
+  // wins (forcedWin) or loses against every move (forcedLoss) with the game
+  // ending within `plies` plies.
+  bool forcedLoss(const WordBaseState& state, int plies);
+
+  bool forcedWin(const WordBaseState& state, int plies) {
+    for (const auto& move : state.get_legal_moves(INF)) {
+      WordBaseState child(state);
+      child.make_move(move);
+      if (child.is_terminal() ? child.get_goodness() < 0 : forcedLoss(child, plies - 1)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool forcedLoss(const WordBaseState& state, int plies) {
+    const auto moves = state.get_legal_moves(INF);
+    if (plies < 2 || moves.empty()) {
+      return false;
+    }
+    for (const auto& move : moves) {
+      WordBaseState child(state);
+      child.make_move(move);
+      if (child.is_terminal() ? child.get_goodness() < 0 : !forcedWin(child, plies - 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Words from a full-dictionary game on kReadmeBoard that races to the
+  // home rows within a couple of dozen plies.
+  const char* const kRaceWords =
+    "perilled\natheist\nalegars\ntenailles\ngaloped\nenginers\ninsigne\n"
+    "handlists\ngruelled\ntrenail\nsigners\ntrammelled\nnerts\ndepolarizer\n"
+    "signets\nzlote\nroamer\nrasorial\npeonage\nlarges\nlioniser\ngnomes\n"
+    "depolarized\npteria\ndelayers\norganelle\n";
+
+  // Along a game, every solver verdict is the shortest forced result, and
+  // Minimax plays proven moves without searching.
+  TEST_F(ParallelSearchTest, ProofNumberSearchFindsShortestForcedResult) {
+    std::istringstream raceWords(kRaceWords);
+    WordDictionary raceDictionary(raceWords);
+    BoardStatic raceBoard(kReadmeBoard, raceDictionary);
+    WordBaseState start(&raceBoard, PLAYER_1);
+
+    Minimax<WordBaseState, WordBaseMove> mover(10.0, 200);
+    mover.setMaxDepth(2);
+    mover.setTraceStream(nullptr);
+    Minimax<WordBaseState, WordBaseMove>::SolverConfig off;
+    off.enabled = false;
+    mover.setSolverConfig(off);
+
+    ProofNumberSearch<WordBaseState, WordBaseMove> solver;
+    WordBaseState game(start);
+    int proven = 0;
+    for (int ply = 0; ply < 40 && !game.is_terminal() && !game.get_legal_moves(INF).empty(); ply++) {
+      WordBaseState s0(game);
+      const auto outcome = solver.solve(&s0);
+      EXPECT_TRUE(s0 == game);
+      const int d = outcome.distance;
+      if (outcome.result == ProofResult::Win) {
+        EXPECT_TRUE(forcedWin(game, d)) << "ply " << ply;
+        EXPECT_FALSE(forcedWin(game, d - 2)) << "ply " << ply;
+        WordBaseState child(game);
+        child.make_move(outcome.move);
+        EXPECT_TRUE(child.is_terminal() ? d == 1 : forcedLoss(child, d - 1)) << "ply " << ply;
+      } else if (outcome.result == ProofResult::Loss) {
+        EXPECT_TRUE(forcedLoss(game, d)) << "ply " << ply;
+        EXPECT_FALSE(forcedLoss(game, d - 2)) << "ply " << ply;
+        EXPECT_FALSE(forcedWin(game, d - 1)) << "ply " << ply;
+      } else {
+        EXPECT_FALSE(forcedWin(game, 5)) << "ply " << ply;
+        EXPECT_FALSE(forcedLoss(game, 4)) << "ply " << ply;
+      }
+
+      if (outcome.result != ProofResult::Unknown) {
+        ++proven;
+        Minimax<WordBaseState, WordBaseMove> engine(10.0, 200);
+        engine.setMaxDepth(4);
+        engine.setTraceStream(nullptr);
+        Minimax<WordBaseState, WordBaseMove>::SolverConfig always;
+        always.race_distance = INF;
+        engine.setSolverConfig(always);
+        WordBaseState s1(game);
+        EXPECT_EQ(engine.get_move(&s1).mLegalWordId, outcome.move.mLegalWordId);
+        const auto& stats = engine.getLastSearchStats();
+        EXPECT_EQ(stats.stop_reason, SearchStopReason::Proven);
+        EXPECT_EQ(stats.proof_result, outcome.result);
+        EXPECT_EQ(stats.goodness, (outcome.result == ProofResult::Win ? 1 : -1) * (INF - d));
+      }
+      WordBaseState s2(game);
+      game.make_move(mover.get_move(&s2));
+    }
+    EXPECT_GT(proven, 0);
+  }
+
+  // Along race games, the threat checks agree with brute force: a win in
+  // one is found exactly when there is one, an enemy threat exactly when
+  // a pass would lose at once, and every move that stops the threat is a
+  // defending move. A lost position scores as a mate in two.
+  TEST_F(ParallelSearchTest, ThreatChecksMatchBruteForce) {
+    std::istringstream raceWords(kRaceWords);
+    WordDictionary raceDictionary(raceWords);
+    BoardStatic raceBoard(kReadmeBoard, raceDictionary);
+
+    // After each of a few openings, both sides play their best move by
+    // static goodness, which races without defending.
+    int wins = 0, threats = 0, lost = 0;
+    for (const auto& opening : WordBaseState(&raceBoard, PLAYER_1).get_legal_moves(8)) {
+      WordBaseState game(&raceBoard, PLAYER_1);
+      game.make_move(opening);
+      for (int ply = 1; ply < 40 && !game.is_terminal() && !game.get_legal_moves(INF).empty(); ply++) {
+        WordBaseMove win;
+        const bool found = game.find_winning_move(win);
+        EXPECT_EQ(found, forcedWin(game, 1)) << "ply " << ply;
+        if (found) {
+          ++wins;
+          WordBaseState child(game);
+          child.make_move(win);
+          EXPECT_TRUE(child.is_terminal() && child.get_goodness() < 0) << "ply " << ply;
+        }
+
+        WordBaseState passed(game);
+        ASSERT_TRUE(passed.make_null_move());
+        const bool threat = game.enemy_threatens_win();
+        EXPECT_EQ(threat, forcedWin(passed, 1)) << "ply " << ply;
+        if (threat && !found) {
+          ++threats;
+          std::vector<WordBaseMove> defences;
+          game.fill_defending_moves(defences, INF);
+          for (const auto& move : game.get_legal_moves(INF)) {
+            WordBaseState child(game);
+            child.make_move(move);
+            if (!forcedWin(child, 1)) {
+              EXPECT_TRUE(std::any_of(defences.begin(), defences.end(), [&](const WordBaseMove& d) {
+                return d.mLegalWordId == move.mLegalWordId;
+              })) << "ply " << ply;
+            }
+          }
+          if (forcedLoss(game, 2)) {
+            ++lost;
+            Minimax<WordBaseState, WordBaseMove> engine(10.0, 200);
+            engine.setMaxDepth(2);
+            engine.setTraceStream(nullptr);
+            Minimax<WordBaseState, WordBaseMove>::SolverConfig off;
+            off.enabled = false;
+            engine.setSolverConfig(off);
+            WordBaseState s0(game);
+            engine.get_move(&s0);
+            EXPECT_EQ(engine.getLastSearchStats().goodness, -(INF - 2)) << "ply " << ply;
+            EXPECT_GT(engine.getLastSearchStats().win_in_one_cuts, 0) << "ply " << ply;
+          }
+        }
+        game.make_move(game.get_legal_moves(1)[0]);
+      }
+    }
+    EXPECT_GT(wins, 0);
+    EXPECT_GT(threats, 0);
+    EXPECT_GT(lost, 0);
+  }
+
+  // A saved book loads back with the same entries, and probing answers
+  // exactly the positions that were added.
+  TEST_F(ParallelSearchTest, OpeningBookRoundTripsAndProbes) {
+    Minimax<WordBaseState, WordBaseMove> engine(10.0, 200);
+    engine.setMaxDepth(2);
+    engine.setTraceStream(nullptr);
+    engine.setMultiPV(2);
+    WordBaseState s0(*state);
+    engine.get_move(&s0);
+    const auto& lines = engine.getRootLines();
+    ASSERT_EQ(lines.size(), 2u);
+
+    OpeningBook book(kReadmeBoard, *board);
+    for (size_t rank = 0; rank < lines.size(); rank++) {
+      book.add(*state, lines[rank].move, lines[rank].score, 2, static_cast<int>(rank));
+    }
+    const std::string path = ::testing::TempDir() + "opening-book-test.bin";
+    book.save(path);
+
+    OpeningBook loaded = OpeningBook::load(path);
+    EXPECT_EQ(loaded.boardText(), kReadmeBoard);
+    EXPECT_TRUE(loaded.matches(*board));
+    EXPECT_EQ(loaded.size(), 2u);
+    const auto entries = loaded.lookup(*state);
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[1].move, lines[1].move.mLegalWordId);
+    EXPECT_EQ(entries[1].score, lines[1].score);
+
+    OpeningBookEntry best;
+    ASSERT_TRUE(loaded.probe(*state, best));
+    EXPECT_EQ(best.move, lines[0].move.mLegalWordId);
+    EXPECT_EQ(best.rank, 0);
+    EXPECT_EQ(best.depth, 2);
+
+    WordBaseState child(*state);
+    child.make_move(lines[0].move);
+    EXPECT_FALSE(loaded.probe(child, best));
+
+    // A corrupt entry count is caught before it sizes anything.
+    {
+      std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+      file.seekp(8 + 4 + std::strlen(kReadmeBoard) + 4 + 8);
+      const uint32_t hugeCount = 0xFFFFFFFFu;
+      file.write(reinterpret_cast<const char*>(&hugeCount), sizeof(hugeCount));
+    }
+    EXPECT_THROW(OpeningBook::load(path), std::runtime_error);
+
+    // A book built with another dictionary is rejected.
+    std::istringstream otherWords(kRaceWords);
+    WordDictionary otherDictionary(otherWords);
+    BoardStatic otherBoard(kReadmeBoard, otherDictionary);
+    OpeningBook other(kReadmeBoard, otherBoard);
+    EXPECT_NE(OpeningBook::legalWordsChecksum(otherBoard), OpeningBook::legalWordsChecksum(*board));
+    EXPECT_TRUE(other.matches(otherBoard));
+    EXPECT_FALSE(other.matches(*board));
+
+    std::ofstream(path, std::ios::binary) << "not a book";
+    EXPECT_THROW(OpeningBook::load(path), std::runtime_error);
+    std::remove(path.c_str());
+  }
+
+  // The wide entry layout is a drop-in for Minimax and the shared-TT strategies.
+  TEST_F(ParallelSearchTest, WideTTEntryLayoutSearchesLikePackedLayout) {
+    Minimax<WordBaseState, WordBaseMove> packed(10.0, 200);
+    packed.setMaxDepth(4);
+    packed.setTraceStream(nullptr);
+    WordBaseState s0(*state);
+    packed.get_move(&s0);
+
+    Minimax<WordBaseState, WordBaseMove, WideTTEntry<WordBaseMove>> wide(10.0, 200);
+    wide.setMaxDepth(4);
+    wide.setTraceStream(nullptr);
+    WordBaseState s1(*state);
+    wide.get_move(&s1);
+
+    EXPECT_EQ(wide.getLastSearchStats().max_depth, 4);
+    EXPECT_EQ(wide.getLastSearchStats().goodness, packed.getLastSearchStats().goodness);
+    EXPECT_GT(wide.getLastSearchStats().tt_hits, 0);
+
+    LazySMPSearch<WordBaseState, WordBaseMove, WideTTEntry<WordBaseMove>> smp(2, 10.0, 200, 3);
+    WordBaseState s2(*state);
+    EXPECT_GE(smp.get_move(&s2).mLegalWordId, 0);
+    EXPECT_EQ(smp.getLastSearchStats().max_depth, 3);
+  }
+
   // Root-level parallelism: returns a valid move and produces aggregate stats.
   TEST_F(ParallelSearchTest, RootParallelReturnsValidMove) {
     RootParallelSearch<WordBaseState, WordBaseMove> algo(2, 1.0, 200, 3);
@@ -545,6 +1342,103 @@ namespace {
     EXPECT_GT(stats.max_depth, 0);
   }
 
+  // Lazy SMP keeps its shared TT and engines between moves, so searching
+  // the same position again starts from warm entries.
+  TEST_F(ParallelSearchTest, LazySMPReusesSharedTTAcrossMoves) {
+    LazySMPSearch<WordBaseState, WordBaseMove> algo(2, 10.0, 200, 4);
+    WordBaseState first(*state);
+    algo.get_move(&first);
+    const auto cold = algo.getLastSearchStats();
+
+    WordBaseState second(*state);
+    algo.get_move(&second);
+    const auto warm = algo.getLastSearchStats();
+
+    EXPECT_EQ(warm.max_depth, 4);
+    EXPECT_LT(warm.nodes, cold.nodes);
+    EXPECT_GT(warm.tt_hits, 0);
+  }
+
+  // Each pool slot runs on the same worker thread every time, never the
+  // caller's, and wait() returns only once every posted task has finished.
+  TEST_F(ParallelSearchTest, SearchThreadPoolKeepsSlotsOnTheirWorkers) {
+    SearchThreadPool pool;
+    pool.reserve(3);
+    std::vector<std::thread::id> firstIds(3), ids(3);
+    std::atomic<int> finished{0};
+    for (int round = 0; round < 20; round++) {
+      for (int t = 0; t < 3; t++) {
+        pool.post(t, [&, t]() {
+          std::this_thread::sleep_for(std::chrono::microseconds(200 * t));
+          ids[t] = std::this_thread::get_id();
+          ++finished;
+        });
+      }
+      pool.wait();
+      EXPECT_EQ(finished.load(), 3 * (round + 1));
+      if (round == 0) firstIds = ids;
+      EXPECT_EQ(ids, firstIds);
+    }
+    EXPECT_NE(firstIds[0], std::this_thread::get_id());
+    EXPECT_NE(firstIds[0], firstIds[1]);
+    EXPECT_NE(firstIds[1], firstIds[2]);
+  }
+
+  // Algorithm::stop() from another thread ends an open-ended (ponder)
+  // search early, for a single engine and for every thread of a strategy.
+  // The synthetic binary tree without a TT is far too big to finish.
+  TEST_F(ParallelSearchTest, StopEndsOpenEndedSearch) {
+    auto searchUntilStopped = [](Algorithm<TestState, TestMove>& algo) {
+      std::thread stopper([&algo]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        algo.stop();
+      });
+      Timer timer;
+      timer.start();
+      TestState searchState(PLAYER_1, 0, 64);
+      TestMove move = algo.get_move(&searchState);
+      stopper.join();
+      EXPECT_LT(timer.seconds_elapsed(), 5.0);
+      return move;
+    };
+
+    Minimax<TestState, TestMove> engine(3600.0);
+    engine.setMaxDepth(64);
+    engine.setUseTranspositionTable(false);
+    engine.setTraceStream(nullptr);
+    EXPECT_GT(searchUntilStopped(engine).mId, 0);
+    EXPECT_LT(engine.getLastSearchStats().max_depth, 64);
+    EXPECT_EQ(engine.getLastSearchStats().stop_reason, SearchStopReason::Stopped);
+
+    LazySMPSearch<TestState, TestMove> smp(2, 3600.0, INF, 64, false);
+    EXPECT_GT(searchUntilStopped(smp).mId, 0);
+    EXPECT_LT(smp.getLastSearchStats().max_depth, 64);
+    EXPECT_EQ(smp.getLastSearchStats().stop_reason, SearchStopReason::Stopped);
+
+    // A stop sent before the search starts is not lost: it ends that search.
+    Timer timer;
+    timer.start();
+    engine.stop();
+    TestState early(PLAYER_1, 0, 64);
+    engine.get_move(&early);
+    EXPECT_LT(timer.seconds_elapsed(), 5.0);
+    EXPECT_EQ(engine.getLastSearchStats().stop_reason, SearchStopReason::Stopped);
+
+    // A withdrawn stop ends nothing.
+    engine.setMaxDepth(3);
+    engine.stop();
+    engine.clear_stop();
+    TestState withdrawn(PLAYER_1, 0, 64);
+    engine.get_move(&withdrawn);
+    EXPECT_EQ(engine.getLastSearchStats().max_depth, 3);
+
+    // The stop does not leak into the next search.
+    smp.setMaxDepth(3);
+    TestState next(PLAYER_1, 0, 64);
+    smp.get_move(&next);
+    EXPECT_EQ(smp.getLastSearchStats().max_depth, 3);
+  }
+
   // YBWC: returns a valid move and produces reasonable stats.
   TEST_F(ParallelSearchTest, YBWCReturnsValidMove) {
     YBWCSearch<WordBaseState, WordBaseMove> algo(2, 1.0, 200, 3);
@@ -557,6 +1451,61 @@ namespace {
     EXPECT_GT(stats.max_depth, 0);
   }
 
+  // The busy-move table answers for exactly the entered pair until it is
+  // left, and ABDADA threads sharing it complete the search.
+  TEST_F(ParallelSearchTest, ABDADASharesBusyMovesAndReturnsValidMove) {
+    BusyMoveTable busy;
+    const uint64_t key = BusyMoveTable::key(state->hash(), 7);
+    const uint64_t other = BusyMoveTable::key(state->hash(), 8);
+    EXPECT_NE(key, 0u);
+    EXPECT_NE(key, other);
+    EXPECT_FALSE(busy.busy(key));
+    busy.enter(key);
+    EXPECT_TRUE(busy.busy(key));
+    EXPECT_FALSE(busy.busy(other));
+    busy.leave(other);
+    EXPECT_TRUE(busy.busy(key));
+    busy.leave(key);
+    EXPECT_FALSE(busy.busy(key));
+
+    ABDADASearch<WordBaseState, WordBaseMove> algo(4, 10.0, 200, 4);
+    for (int turn = 0; turn < 2; turn++) {
+      WordBaseState searchState(*state);
+      WordBaseMove move = algo.get_move(&searchState);
+      EXPECT_TRUE(state->isValidMove(move));
+      EXPECT_EQ(algo.getLastSearchStats().max_depth, 4);
+    }
+  }
+
+  TEST_F(ParallelSearchTest, LazySMPHelpersSkipStaggeredDepths) {
+    Minimax<WordBaseState, WordBaseMove> engine(10.0, 200);
+    engine.setMaxDepth(6);
+    for (int depth = 1; depth <= 6; depth++) {
+      EXPECT_FALSE(engine.helper_skips_depth(depth));
+    }
+    // Helpers 1 and 2 skip alternate depths, out of phase; none skips the
+    // max depth.
+    engine.setHelperIndex(1);
+    EXPECT_TRUE(engine.helper_skips_depth(1));
+    EXPECT_FALSE(engine.helper_skips_depth(2));
+    EXPECT_TRUE(engine.helper_skips_depth(3));
+    engine.setHelperIndex(2);
+    EXPECT_FALSE(engine.helper_skips_depth(1));
+    EXPECT_TRUE(engine.helper_skips_depth(2));
+    for (int helper = 1; helper < 24; helper++) {
+      engine.setHelperIndex(helper);
+      EXPECT_FALSE(engine.helper_skips_depth(6));
+    }
+
+    LazySMPSearch<WordBaseState, WordBaseMove> algo(8, 10.0, 200, 4);
+    for (int turn = 0; turn < 2; turn++) {
+      WordBaseState searchState(*state);
+      WordBaseMove move = algo.get_move(&searchState);
+      EXPECT_TRUE(state->isValidMove(move));
+      EXPECT_EQ(algo.getLastSearchStats().max_depth, 4);
+    }
+  }
+
   // All three strategies should agree on the best move at a deterministic depth.
   // Use depth 2 to keep it fast and predictable.
   TEST_F(ParallelSearchTest, AllStrategiesAgreeAtShallowDepth) {
@@ -22,15 +22,24 @@
 #include <functional>
 #include <sys/time.h>
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <assert.h>
 #include <sstream>
 #include <iomanip>
 #include <memory>
+#include <type_traits>
 #include <vector>
 #include <random>
 #include <cstdint>
+#include <cstdlib>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 #include "easylogging++.h"
+#ifdef WORDBASE_USE_SIMD
+#include <immintrin.h>
+#endif
 
 
 static const int MAX_SIMULATIONS = 10000000;
@@ -80,6 +89,66 @@ struct Timer {
   }
 };
 
+// Stop token for Algorithm::stop(). Searches poll it with relaxed loads;
+// raising it from any thread ends the search at the next check. request()
+// is the caller's stop, raise() the search's own (deadline, main thread
+// done); both live in one atomic so a search that sees the token raised
+// also sees which. The search clears it when it returns, so a request
+// made before a search starts ends that search. Copies start un-raised
+// (algorithms holding one stay copyable).
+struct StopSignal {
+  static constexpr uint8_t RAISED = 1;
+  static constexpr uint8_t REQUESTED = 2;
+  std::atomic<uint8_t> state{0};
+
+  StopSignal() = default;
+  StopSignal(const StopSignal&) {}
+  StopSignal& operator=(const StopSignal&) { return *this; }
+
+  void raise() { state.fetch_or(RAISED, std::memory_order_relaxed); }
+  void request() { state.fetch_or(RAISED | REQUESTED, std::memory_order_relaxed); }
+  void clear() { state.store(0, std::memory_order_relaxed); }
+  bool raised() const { return state.load(std::memory_order_relaxed) != 0; }
+  bool requested() const { return (state.load(std::memory_order_relaxed) & REQUESTED) != 0; }
+};
+
+// The (position, move) pairs some thread is searching right now, shared
+// by the engines of an ABDADA search (see Minimax::setBusyMoveTable). A
+// thread that finds a move busy searches the node's other moves first
+// and comes back to it last, when the TT usually has its result.
+//
+// Direct-mapped, one relaxed atomic per slot. Lossy by design: a
+// colliding pair overwrites the slot, which only makes a busy move look
+// free, and a move is never wrongly skipped, just searched later.
+class BusyMoveTable {
+  static constexpr int SIZE_BITS = 15;
+  std::unique_ptr<std::atomic<uint64_t>[]> mKeys;
+
+  std::atomic<uint64_t>& slot(uint64_t key) const { return mKeys[key >> (64 - SIZE_BITS)]; }
+
+public:
+  BusyMoveTable() : mKeys(new std::atomic<uint64_t>[size_t(1) << SIZE_BITS]) { clear(); }
+
+  // Never 0, which marks a free slot.
+  static uint64_t key(uint64_t position, int move_id) {
+    return ((position ^ 0x2545F4914F6CDD1DULL) * 0x9E3779B97F4A7C15ULL
+            ^ (static_cast<uint64_t>(move_id) + 1) * 0xD6E8FEB86659FD93ULL) | 1;
+  }
+
+  bool busy(uint64_t key) const { return slot(key).load(std::memory_order_relaxed) == key; }
+  void enter(uint64_t key) { slot(key).store(key, std::memory_order_relaxed); }
+  void leave(uint64_t key) {
+    uint64_t expected = key;
+    slot(key).compare_exchange_strong(expected, 0, std::memory_order_relaxed);
+  }
+
+  void clear() {
+    for (size_t i = 0; i < (size_t(1) << SIZE_BITS); i++) {
+      mKeys[i].store(0, std::memory_order_relaxed);
+    }
+  }
+};
+
 template<class M>
 // Move is used via CRTP (Move<WordBaseMove>), never through base pointers.
 // All methods are non-virtual to eliminate vtable overhead:
@@ -145,6 +214,10 @@ struct TTEntry {
     return static_cast<TTEntryType>(data & 0x3);
   }
 
+  bool empty() const {
+    return data == 0;
+  }
+
   // Compare stored verification key (upper 32 bits of data) against
   // the lower 32 bits of the full 64-bit position key.
   bool matches(uint64_t full_key) const {
@@ -178,7 +251,433 @@ private:
   }
 };
 
+// Wide TT entry: 16 bytes, nothing clipped.
+//
+// Two 64-bit words:
+//   check  = full position key ^ data
+//   data   [31:0]  value       32 bits — signed eval, INF/-INF stored as-is
+//          [47:32] move        16 bits — LegalWordId
+//          [55:48] depth        8 bits — search depth (max 255)
+//          [63:56] generation:6 | value_type:2
+//
+// Costs twice the memory per entry of TTEntry (4 instead of 7 per 64-byte
+// bucket), in exchange for exact scores beyond ±2047, depths beyond 31 and
+// a 64-bit collision check. Select it with Minimax<S, M, WideTTEntry<M>>.
+//
+// The key is stored XORed with the data word (lockless hashing, as in
+// Stockfish): shared-TT threads write the two words separately, and a torn
+// entry, one position's check next to another's data, decodes to a key
+// that matches neither position.
+template<class M>
+struct WideTTEntry {
+  uint64_t check;
+  uint64_t data;
+
+  WideTTEntry() : check(0), data(0) {}
+
+  WideTTEntry(const M &move, uint64_t vkey, int depth, int value, TTEntryType vtype)
+    : data(pack(move.mLegalWordId, value, depth, vtype, 0)) {
+    check = vkey ^ data;
+  }
+
+  M get_move() const {
+    M m;
+    m.mLegalWordId = static_cast<int>((data >> 32) & 0xFFFF);
+    return m;
+  }
+
+  int get_depth() const { return static_cast<int>((data >> 48) & 0xFF); }
+  int get_value() const { return static_cast<int32_t>(static_cast<uint32_t>(data)); }
+  TTEntryType get_value_type() const { return static_cast<TTEntryType>((data >> 56) & 0x3); }
+  uint64_t key() const { return check ^ data; }
+  bool empty() const { return key() == 0; }
+  bool matches(uint64_t full_key) const { return key() == full_key; }
+
+  uint8_t get_generation() const { return static_cast<uint8_t>(data >> 58); }
+  void set_generation(uint8_t generation) {
+    const uint64_t full_key = key();
+    data = (data & ~(0x3FULL << 58)) | (static_cast<uint64_t>(generation & 0x3F) << 58);
+    check = full_key ^ data;
+  }
+
+  std::ostream &to_stream(std::ostream &os) const {
+    return os << "move: " << get_move() << " verification_key: " << key()
+              << " depth: " << get_depth() << " value: " << get_value()
+              << " value_type: " << get_value_type();
+  }
+
+  friend std::ostream &operator<<(std::ostream &os, const WideTTEntry &entry) {
+    return entry.to_stream(os);
+  }
+
+private:
+  static uint64_t pack(int moveId, int value, int depth, TTEntryType vtype, uint8_t generation) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(value))
+         | (static_cast<uint64_t>(moveId & 0xFFFF) << 32)
+         | (static_cast<uint64_t>(std::min(depth, 255) & 0xFF) << 48)
+         | (static_cast<uint64_t>(vtype & 0x3) << 56)
+         | (static_cast<uint64_t>(generation & 0x3F) << 58);
+  }
+};
+
+// --- Bucketed transposition table ---
+//
+// One 64-byte cache line per index instead of one entry. The bucket layout
+// depends on the entry type (see the TTBucket specializations below), e.g.
+// for the packed 8-byte TTEntry:
+//
+//   [ entry 0 | entry 1 | ... | entry 6 | gen 0..6 | pad ]
+//     7 x 8-byte TTEntry                  7 x 1-byte search generation
+//
+// A probe touches exactly one cache line and checks every verification key
+// in it (with AVX2 when WORDBASE_USE_SIMD is set). A store picks its slot
+// with a depth/bound/age policy instead of always replacing:
+//
+//   1. Same position already in the bucket: overwrite it, unless the old
+//      entry is much deeper, from this search, and the new one is only a
+//      bound (keeps an expensive result from being clobbered by a shallow
+//      re-probe with a different window).
+//   2. Otherwise overwrite the least valuable slot, where empty slots go
+//      first and value = depth + 2 (if EXACT) - 4 * searches-since-written.
+//
+// Example: a depth-9 EXACT entry written this search is worth 11; a depth-1
+// bound from the previous search is worth 1 - 4 = -3, so new depth-1 noise
+// lands on the stale shallow slot and the deep entry survives. Three
+// searches later the deep entry is worth 11 - 12 = -1 and can be evicted.
+//
+// Memory matches the old flat table for the same size_bits: 2^size_bits
+// 8-byte entries' worth of space, i.e. 2^(size_bits-3) buckets.
+//
+// Shared-TT parallel modes race on buckets without locks. A packed entry
+// is a single 8-byte word, so it is never torn; a wide entry's two words
+// can be, and its XOR-ed key then fails to match (see WideTTEntry). A
+// stale entry is only as wrong as any hash collision, and moves read from
+// the table are checked with isValidMove. new_search() must be called by
+// the owner before worker threads start, not by each worker.
+template<class E>
+struct TTBucket;
+
+template<class M>
+struct alignas(64) TTBucket<TTEntry<M>> {
+  static constexpr int kEntries = 7;
+  static constexpr uint8_t kGenerationMask = 0xFF;
+  TTEntry<M> entries[kEntries];
+  uint8_t generations[kEntries];
+  uint8_t padding;
+
+  uint8_t generation(int i) const { return generations[i]; }
+  void set_generation(int i, uint8_t generation) { generations[i] = generation; }
+
+  // Index of the slot whose stored key matches verificationKey, or -1.
+  int find(uint64_t verificationKey) const {
+#ifdef WORDBASE_USE_SIMD
+    // Treat the bucket as 8 uint64 lanes; lane 7 is the generation bytes and
+    // is masked out. Compare the upper 32 bits of each lane (the stored key)
+    // against the probe key in two 4-lane compares.
+    const uint64_t* lanes = reinterpret_cast<const uint64_t*>(this);
+    const __m256i key = _mm256_set1_epi64x(static_cast<long long>(verificationKey & 0xFFFFFFFF));
+    const __m256i lo = _mm256_srli_epi64(_mm256_load_si256(reinterpret_cast<const __m256i*>(lanes)), 32);
+    const __m256i hi = _mm256_srli_epi64(_mm256_load_si256(reinterpret_cast<const __m256i*>(lanes + 4)), 32);
+    const int mask = (_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(lo, key)))
+                      | (_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(hi, key))) << 4))
+                     & ((1 << kEntries) - 1);
+    return mask ? __builtin_ctz(mask) : -1;
+#else
+    for (int i = 0; i < kEntries; i++) {
+      if (entries[i].matches(verificationKey)) {
+        return i;
+      }
+    }
+    return -1;
+#endif
+  }
+};
+
+// Wide entries carry their own 6-bit generation, so four fill the line.
+template<class M>
+struct alignas(64) TTBucket<WideTTEntry<M>> {
+  static constexpr int kEntries = 4;
+  static constexpr uint8_t kGenerationMask = 0x3F;
+  WideTTEntry<M> entries[kEntries];
+
+  uint8_t generation(int i) const { return entries[i].get_generation(); }
+  void set_generation(int i, uint8_t generation) { entries[i].set_generation(generation & kGenerationMask); }
+
+  int find(uint64_t verificationKey) const {
+#ifdef WORDBASE_USE_SIMD
+    // Lanes alternate check, data; XOR each lane with its neighbour to
+    // recover the keys and compare only the even lanes.
+    const uint64_t* lanes = reinterpret_cast<const uint64_t*>(this);
+    const __m256i key = _mm256_set1_epi64x(static_cast<long long>(verificationKey));
+    const __m256i loRaw = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes));
+    const __m256i hiRaw = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes + 4));
+    const __m256i lo = _mm256_xor_si256(loRaw, _mm256_shuffle_epi32(loRaw, 0x4E));
+    const __m256i hi = _mm256_xor_si256(hiRaw, _mm256_shuffle_epi32(hiRaw, 0x4E));
+    const int mask = (_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(lo, key)))
+                      | (_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(hi, key))) << 4))
+                     & 0x55;
+    return mask ? __builtin_ctz(mask) / 2 : -1;
+#else
+    for (int i = 0; i < kEntries; i++) {
+      if (entries[i].matches(verificationKey)) {
+        return i;
+      }
+    }
+    return -1;
+#endif
+  }
+};
+
+// How a table's memory is backed (see TranspositionTable::allocate).
+enum class TTPageMode { Default, Transparent, Explicit };
+
+inline const char* tt_page_mode_name(TTPageMode mode) {
+  switch (mode) {
+    case TTPageMode::Explicit: return "explicit";
+    case TTPageMode::Transparent: return "transparent";
+    default: return "default";
+  }
+}
+
+template<class M, class E = TTEntry<M>>
+class TranspositionTable {
+public:
+  using Bucket = TTBucket<E>;
+  static_assert(sizeof(Bucket) == 64, "TT bucket must be exactly one cache line");
+
+  static constexpr int kBucketBits = 3;  // 64-byte bucket = 8 packed entries' worth of memory
+
+  static constexpr size_t kHugePageBytes = 2ULL << 20;
+
+  TranspositionTable() = default;
+
+  explicit TranspositionTable(size_t sizeBits, bool hugePages = true) { resize(sizeBits, hugePages); }
+
+  TranspositionTable(const TranspositionTable& other) { *this = other; }
+
+  TranspositionTable(TranspositionTable&& other) noexcept { *this = std::move(other); }
+
+  TranspositionTable& operator=(const TranspositionTable& other) {
+    if (this == &other) {
+      return *this;
+    }
+    if (other.empty()) {
+      release();
+      return *this;
+    }
+    resize(other.mSizeBits, other.mPageMode != TTPageMode::Default);
+    std::copy(other.mBuckets, other.mBuckets + other.mBucketCount, mBuckets);
+    mGeneration = other.mGeneration;
+    return *this;
+  }
+
+  TranspositionTable& operator=(TranspositionTable&& other) noexcept {
+    if (this != &other) {
+      release();
+      mBuckets = other.mBuckets;
+      mBucketCount = other.mBucketCount;
+      mBucketMask = other.mBucketMask;
+      mAllocatedBytes = other.mAllocatedBytes;
+      mSizeBits = other.mSizeBits;
+      mPageMode = other.mPageMode;
+      mGeneration = other.mGeneration;
+      other.mBuckets = nullptr;
+      other.release();
+    }
+    return *this;
+  }
+
+  ~TranspositionTable() { release(); }
+
+  // Largest size_bits whose table fits in `megabytes` (tables stay a power
+  // of two so the bucket index is a mask). 64 MB -> 23 bits.
+  static size_t size_bits_for_mb(size_t megabytes) {
+    const size_t entries = (std::max<size_t>(megabytes, 1) << 20) / sizeof(TTEntry<M>);
+    size_t bits = kBucketBits;
+    while ((2ULL << bits) <= entries) bits++;
+    return bits;
+  }
+
+  // (Re)allocate to 2^sizeBits packed entries' worth of memory and clear.
+  void resize(size_t sizeBits, bool hugePages = true) {
+    release();
+    mSizeBits = std::max<size_t>(sizeBits, kBucketBits);
+    mBucketCount = 1ULL << (mSizeBits - kBucketBits);
+    mBucketMask = mBucketCount - 1;
+    allocate(mBucketCount * sizeof(Bucket), hugePages);
+    std::uninitialized_fill_n(mBuckets, mBucketCount, Bucket{});
+    mGeneration = 0;
+  }
+
+  // Drop all storage (for engines that use a shared table instead).
+  void release() {
+    if (mBuckets != nullptr) {
+#ifdef __linux__
+      if (mPageMode == TTPageMode::Explicit) {
+        munmap(mBuckets, mAllocatedBytes);
+      } else {
+        std::free(mBuckets);
+      }
+#else
+      std::free(mBuckets);
+#endif
+    }
+    mBuckets = nullptr;
+    mBucketCount = 0;
+    mBucketMask = 0;
+    mAllocatedBytes = 0;
+    mSizeBits = 0;
+    mPageMode = TTPageMode::Default;
+  }
+
+  void clear() {
+    std::fill(mBuckets, mBuckets + mBucketCount, Bucket{});
+    mGeneration = 0;
+  }
+
+  // Pull the bucket for `hash` toward L1 without waiting for it. Issue this
+  // as soon as a child position's hash is known; by the time the child
+  // probes, the line has usually arrived.
+  void prefetch(uint64_t hash) const {
+    __builtin_prefetch(&mBuckets[hash & mBucketMask]);
+  }
+
+  // Start a new search: entries written from now on are "younger" than all
+  // existing ones, which then lose replacement priority as they age.
+  void new_search() { mGeneration = (mGeneration + 1) & Bucket::kGenerationMask; }
+
+  uint8_t generation() const { return mGeneration; }
+  size_t size_bits() const { return mSizeBits; }
+  size_t size_bytes() const { return mBucketCount * sizeof(Bucket); }
+  TTPageMode page_mode() const { return mPageMode; }
+  bool empty() const { return mBucketCount == 0; }
+
+  // Number of usable entry slots.
+  size_t capacity() const { return mBucketCount * Bucket::kEntries; }
+
+  // Number of non-empty slots (diagnostics/tests; scans the whole table).
+  size_t count_populated() const {
+    size_t populated = 0;
+    for (size_t b = 0; b < mBucketCount; b++) {
+      for (int i = 0; i < Bucket::kEntries; i++) {
+        if (!mBuckets[b].entries[i].empty()) populated++;
+      }
+    }
+    return populated;
+  }
+
+  bool probe(uint64_t hash, uint64_t verificationKey, E &entry) const {
+    const Bucket& bucket = mBuckets[hash & mBucketMask];
+    const int slot = bucket.find(verificationKey);
+    if (slot < 0) {
+      return false;
+    }
+    // Re-check the copy: another thread may have rewritten the slot since
+    // find(), and a wide entry read mid-write must not be used.
+    entry = bucket.entries[slot];
+    return entry.matches(verificationKey);
+  }
+
+  void store(uint64_t hash, uint64_t verificationKey, const E &entry) {
+    Bucket& bucket = mBuckets[hash & mBucketMask];
+    int slot = bucket.find(verificationKey);
+    if (slot >= 0) {
+      const E& old = bucket.entries[slot];
+      if (entry.get_value_type() != TTEntryType::EXACT_VALUE
+          && bucket.generation(slot) == mGeneration
+          && old.get_depth() > entry.get_depth() + 2) {
+        return;
+      }
+    } else {
+      slot = 0;
+      int lowestWorth = worth(bucket, 0);
+      for (int i = 1; i < Bucket::kEntries && lowestWorth > INT32_MIN; i++) {
+        const int w = worth(bucket, i);
+        if (w < lowestWorth) {
+          lowestWorth = w;
+          slot = i;
+        }
+      }
+    }
+    bucket.entries[slot] = entry;
+    bucket.set_generation(slot, mGeneration);
+  }
+
+private:
+  Bucket* mBuckets = nullptr;
+  size_t mBucketCount = 0;
+  size_t mBucketMask = 0;
+  size_t mAllocatedBytes = 0;
+  size_t mSizeBits = 0;
+  TTPageMode mPageMode = TTPageMode::Default;
+  uint8_t mGeneration = 0;
+
+  // Random probes into a large table miss the TLB as well as the cache:
+  // at 2^24 entries (128 MB) 4 KB pages need 32K TLB entries, 2 MB pages
+  // need 64. On Linux, tables of at least one huge page first try explicit
+  // huge pages (MAP_HUGETLB; needs vm.nr_hugepages reserved), then a
+  // 2 MB-aligned heap block with madvise(MADV_HUGEPAGE) so transparent huge
+  // pages can back it. Otherwise, or with hugePages=false, plain 64-byte
+  // aligned memory.
+  void allocate(size_t bytes, bool hugePages) {
+#ifdef __linux__
+    if (hugePages && bytes >= kHugePageBytes) {
+      const size_t rounded = (bytes + kHugePageBytes - 1) & ~(kHugePageBytes - 1);
+      void* mapped = mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (mapped != MAP_FAILED) {
+        mBuckets = static_cast<Bucket*>(mapped);
+        mAllocatedBytes = rounded;
+        mPageMode = TTPageMode::Explicit;
+        return;
+      }
+      void* aligned = std::aligned_alloc(kHugePageBytes, rounded);
+      if (aligned != nullptr) {
+        mBuckets = static_cast<Bucket*>(aligned);
+        mAllocatedBytes = rounded;
+        mPageMode = madvise(aligned, rounded, MADV_HUGEPAGE) == 0 ? TTPageMode::Transparent : TTPageMode::Default;
+        return;
+      }
+    }
+#endif
+    (void)hugePages;
+    mBuckets = static_cast<Bucket*>(std::aligned_alloc(alignof(Bucket), bytes));
+    if (mBuckets == nullptr) {
+      throw std::bad_alloc();
+    }
+    mAllocatedBytes = bytes;
+    mPageMode = TTPageMode::Default;
+  }
+
+  // Replacement value of a slot; empty slots are always the first choice.
+  int worth(const Bucket& bucket, int i) const {
+    const E& e = bucket.entries[i];
+    if (e.empty()) return INT32_MIN;
+    const int age = (mGeneration - bucket.generation(i)) & Bucket::kGenerationMask;
+    return e.get_depth() + (e.get_value_type() == TTEntryType::EXACT_VALUE ? 2 : 0) - 4 * age;
+  }
+};
+
 
+// Base of a game state S (CRTP: S derives from State<S, M>).
+//
+// The search calls S's members directly, never through a vtable, so
+// make_move, get_goodness and the rest can be inlined into Minimax. S
+// provides:
+//   S clone() const;
+//   int get_goodness() const;                 // for player_to_move
+//   std::vector<M> get_legal_moves(int max_moves) const;
+//   char get_enemy(char player) const;
+//   bool is_terminal() const;
+//   bool is_winner(char player) const;
+//   void make_move(const M &move);
+//   std::ostream &to_stream(std::ostream &os) const;
+//   bool operator==(const S &other) const;
+//   size_t hash() const;
+// and may hide any default below (fill_legal_moves, isValidMove,
+// tt_verification_key, swap_players, the snapshot and null-move hooks).
+// Code that needs runtime polymorphism wraps a state in StateAdapter and
+// uses it as an AnyState<M>.
 template<class S, class M>
 struct State {
   unsigned visits = 0;
@@ -189,7 +688,8 @@ struct State {
 
   State(char player_to_move) : player_to_move(player_to_move) {}
 
-  virtual ~State() {}
+  S &self() { return *static_cast<S*>(this); }
+  const S &self() const { return *static_cast<const S*>(this); }
 
   void update_stats(double result) {
     score += result;
@@ -206,7 +706,7 @@ struct State {
   }
 
   std::shared_ptr<S> create_child(M &move) {
-    S child = clone();
+    S child = self().clone();
     child.make_move(move);
     child.parent = (S*) this;
     return std::make_shared<S>(child);
@@ -229,28 +729,14 @@ struct State {
     return it->second.get();
   }
 
-  virtual void swap_players() {}
-
-  virtual S clone() const = 0;
-
-  virtual int get_goodness() const = 0;
-
-  virtual std::vector<M> get_legal_moves(int max_moves) const = 0;
+  void swap_players() {}
 
   // Fill a caller-provided vector with legal moves, reusing its capacity.
   // Default implementation delegates to get_legal_moves; subclasses can override.
-  virtual void fill_legal_moves(std::vector<M>& out, int max_moves) const {
-    out = get_legal_moves(max_moves);
+  void fill_legal_moves(std::vector<M>& out, int max_moves) const {
+    out = self().get_legal_moves(max_moves);
   }
 
-  virtual char get_enemy(char player) const = 0;
-
-  virtual bool is_terminal() const = 0;
-
-  virtual bool is_winner(char player) const = 0;
-
-  virtual void make_move(const M &move) = 0;
-
   // Lightweight snapshot/restore for search undo. Override in game-specific
   // subclasses to avoid copying large fields (e.g., played-word bitsets).
   // Default: full state copy (same as StateUndoer).
@@ -264,24 +750,127 @@ struct State {
   }
   void undoPlayedWords(const M&) {} // no-op for default
 
+  // Null move ("pass") for null-move pruning: hand the turn to the enemy
+  // without touching the position. Games without a meaningful pass keep
+  // this default, which reports false and leaves the state unchanged.
+  bool make_null_move() { return false; }
+  void undo_null_move() {}
+
+  // Capture moves for quiescence search, best-first, at most max_moves.
+  // The default has none, which makes quiescence a plain static eval.
+  void fill_capture_moves(std::vector<M>& out, int) const { out.clear(); }
+
+  // How close the game is to being decided, in game-specific steps (rows
+  // for Wordbase): the least either side still needs to win. Minimax tries
+  // the proof-number solver at or below MinimaxSolverConfig::race_distance.
+  // The default is never a race.
+  int race_distance() const { return INF; }
+
+  // Threat checks (see MinimaxSelectiveConfig::win_in_one): a move that
+  // wins the game for the side to move at once, whether the enemy would
+  // have one if it were its turn, and the moves that may stop that one. A
+  // superset is fine: a move that does not stop it loses a ply later. The
+  // defaults see no threats.
+  bool find_winning_move(M&) const { return false; }
+  bool enemy_threatens_win() const { return false; }
+  void fill_defending_moves(std::vector<M>& out, int max_moves) const {
+    self().fill_legal_moves(out, max_moves);
+  }
+
+  // Upper bound on the move ids (M::mLegalWordId) this game produces; it
+  // sizes Minimax's continuation-history tables. 0 means unknown.
+  int move_id_count() const { return 0; }
+
   // Check whether a move is valid for the current player.
   // Used to validate transposition table entries against hash collisions.
   // Default returns true; override in game-specific subclasses.
-  virtual bool isValidMove(const M &) const { return true; }
+  bool isValidMove(const M &) const { return true; }
+
+  friend std::ostream &operator<<(std::ostream &os, const State &state) {
+    return state.self().to_stream(os);
+  }
+
+  uint64_t tt_verification_key() const {
+    return static_cast<uint64_t>(self().hash());
+  }
+};
+
+// Runtime-polymorphic view of a game state, for code that would rather
+// pay a virtual call per operation than be a template over S: tools that
+// pick the game at run time, or hold states of several games. The search
+// itself works on the concrete S (see State).
+template<class M>
+struct AnyState {
+  virtual ~AnyState() {}
+
+  virtual std::unique_ptr<AnyState> clone() const = 0;
+
+  virtual char get_player_to_move() const = 0;
+
+  virtual int get_goodness() const = 0;
+
+  virtual std::vector<M> get_legal_moves(int max_moves = INF) const = 0;
+
+  virtual char get_enemy(char player) const = 0;
+
+  virtual bool is_terminal() const = 0;
+
+  virtual bool is_winner(char player) const = 0;
+
+  virtual void make_move(const M &move) = 0;
+
+  virtual bool isValidMove(const M &move) const = 0;
+
+  virtual size_t hash() const = 0;
+
+  virtual uint64_t tt_verification_key() const = 0;
 
   virtual std::ostream &to_stream(std::ostream &os) const = 0;
 
-  friend std::ostream &operator<<(std::ostream &os, const State &state) {
+  friend std::ostream &operator<<(std::ostream &os, const AnyState &state) {
     return state.to_stream(os);
   }
+};
+
+// Owns an S and forwards AnyState's interface to it.
+template<class S, class M>
+class StateAdapter : public AnyState<M> {
+  S mState;
 
-  virtual bool operator==(const S &other) const = 0;
+public:
+  explicit StateAdapter(const S &state) : mState(state) {}
 
-  virtual size_t hash() const = 0;
+  S &state() { return mState; }
+  const S &state() const { return mState; }
 
-  virtual uint64_t tt_verification_key() const {
-    return static_cast<uint64_t>(hash());
+  std::unique_ptr<AnyState<M>> clone() const override {
+    return std::make_unique<StateAdapter>(mState);
   }
+
+  char get_player_to_move() const override { return mState.player_to_move; }
+
+  int get_goodness() const override { return mState.get_goodness(); }
+
+  std::vector<M> get_legal_moves(int max_moves = INF) const override {
+    return mState.get_legal_moves(max_moves);
+  }
+
+  char get_enemy(char player) const override { return mState.get_enemy(player); }
+
+  bool is_terminal() const override { return mState.is_terminal(); }
+
+  bool is_winner(char player) const override { return mState.is_winner(player); }
+
+  void make_move(const M &move) override { mState.make_move(move); }
+
+  bool isValidMove(const M &move) const override { return mState.isValidMove(move); }
+
+  size_t hash() const override { return mState.hash(); }
+
+  uint64_t tt_verification_key() const override { return mState.tt_verification_key(); }
+
+  // Through operator<<, so a game's own printer for S wins over to_stream.
+  std::ostream &to_stream(std::ostream &os) const override { return os << mState; }
 };
 
 template<class S, class M>
@@ -296,6 +885,15 @@ struct Algorithm {
 
   virtual M get_move(S *state) = 0;
 
+  // Ask get_move to return as soon as possible; callable from any thread.
+  // One call ends the running search, or the next one if none is running:
+  // the request stays pending until a search returns. Default: no-op.
+  virtual void stop() {}
+
+  // Withdraw a stop() that no search has consumed yet, e.g. one sent to a
+  // search that had already returned. Call only while no search runs.
+  virtual void clear_stop() {}
+
   virtual std::string read_log() const {
     return "";
   }
@@ -330,94 +928,912 @@ struct Human : public Algorithm<S, M> {
     }
   }
 
-  std::string get_name() const {
-    return "Human";
-  }
+  std::string get_name() const {
+    return "Human";
+  }
+};
+
+template<class M>
+struct MinimaxResult {
+  int goodness;
+  M best_move;
+  bool completed;
+};
+
+
+class IndentingOStreambuf : public std::streambuf
+{
+  std::streambuf*     myDest;
+  bool                myIsAtStartOfLine;
+  std::string         myIndent;
+  std::ostream*       myOwner;
+protected:
+  virtual int         overflow( int ch )
+  {
+    if ( myIsAtStartOfLine && ch != '\n' ) {
+      myDest->sputn( myIndent.data(), myIndent.size() );
+    }
+    myIsAtStartOfLine = ch == '\n';
+    return myDest->sputc( ch );
+  }
+public:
+  explicit            IndentingOStreambuf(
+                                          std::streambuf* dest, int indent = 4 )
+  : myDest( dest )
+  , myIsAtStartOfLine( true )
+  , myIndent( indent, '.' )
+  , myOwner( NULL )
+  {
+  }
+  explicit            IndentingOStreambuf(
+                                          std::ostream& dest, int indent = 4 )
+  : myDest( dest.rdbuf() )
+  , myIsAtStartOfLine( true )
+  , myIndent( indent, '.' )
+  , myOwner( &dest )
+  {
+    myOwner->rdbuf( this );
+  }
+  virtual             ~IndentingOStreambuf()
+  {
+    if ( myOwner != NULL ) {
+      myOwner->rdbuf( myDest );
+    }
+  }
+};
+
+template<class S, class M>
+class StateUndoer {
+private:
+  S mSavedState;
+  S& mStateToUndo;
+
+public:
+  // Keep undo generic unless a measured hotspot justifies per-state specialization.
+  StateUndoer(S& state, const M&) : mSavedState(state), mStateToUndo(state) {}
+  ~StateUndoer() { mStateToUndo = mSavedState; }
+};
+
+// Outcome of a proof-number search for the side to move at the root.
+enum class ProofResult { Unknown, Win, Loss };
+
+inline const char* proof_result_name(ProofResult result) {
+  switch (result) {
+    case ProofResult::Unknown: return "unknown";
+    case ProofResult::Win: return "win";
+    case ProofResult::Loss: return "loss";
+  }
+  return "unknown";
+}
+
+// Limits for ProofNumberSearch. Games longer than max_ply plies are not
+// looked at, so a proof is exact but a failed one says nothing about
+// longer wins. max_nodes is shared by all horizons.
+struct ProofNumberConfig {
+  int max_nodes = 200000;
+  int max_ply = 5;
+  int tt_size_bits = 18;
+};
+
+template<class M>
+struct ProofNumberOutcome {
+  ProofResult result = ProofResult::Unknown;
+  M move;                // Win: the winning move; Loss: the longest defence
+  int distance = 0;      // plies to the end of the game along the proof
+  int nodes = 0;         // positions generated (make_move calls)
+  double elapsed_seconds = 0.0;
+};
+
+// Depth-first proof-number search (df-pn) for endgames.
+//
+// Proves by force whether the side to move wins or loses, ignoring the
+// evaluation. Proof numbers are in negamax form: phi is the cost of
+// proving a win for the side to move, delta the cost of disproving it;
+// phi(n) = min delta(child) and delta(n) = sum phi(child). The search
+// descends into the child with the smallest delta while both stay under
+// thresholds, with the 1+epsilon trick (the second-best sibling's delta
+// plus a quarter) so it stays in a subtree instead of bouncing between
+// siblings.
+//
+// "Does the attacker win?" is a yes/no question with a ply horizon: a
+// position with no moves, or at the horizon, counts as not won by the
+// attacker. solve() deepens the horizon one ply at a time, asking at odd
+// horizons whether the side to move wins and at even ones whether the
+// opponent does, so the first proof found is the shortest. A wide horizon
+// from the start lets df-pn sink its budget into long lines that a
+// shallow proof would have made pointless.
+//
+// Node values are cached in a table keyed like the Minimax TT (hash() to
+// index, tt_verification_key() to verify), which seeds children when a
+// node is expanded. Each node's loop keeps its children's numbers itself,
+// so a lost entry costs re-work but never a livelock. The game must be
+// acyclic; in Wordbase every move plays a new word, so the ply (and the
+// horizon) is a function of the position.
+template<class S, class M>
+class ProofNumberSearch {
+public:
+  using Config = ProofNumberConfig;
+  using Outcome = ProofNumberOutcome<M>;
+
+  explicit ProofNumberSearch(const Config& config = Config()) : mConfig(config) {}
+
+  void setConfig(const Config& config) { mConfig = config; }
+  const Config& getConfig() const { return mConfig; }
+
+  // Optional stop token, polled like Minimax polls its own.
+  void setStop(const StopSignal* stop) { mStop = stop; }
+
+  // Tries to prove a win or (if prove_loss) a loss for the side to move
+  // within max_ply plies. Gives up after max_nodes positions, max_seconds
+  // (<= 0: no limit) or a stop request.
+  Outcome solve(S *state, double max_seconds = 0.0, bool prove_loss = true) {
+    Outcome outcome;
+    mTimer.start();
+    mMaxSeconds = max_seconds;
+    mNodes = 0;
+    mAborted = false;
+    if (state->is_terminal()) {
+      return outcome;
+    }
+    if (mTable.size() != (size_t(1) << mConfig.tt_size_bits)) {
+      mTable.assign(size_t(1) << mConfig.tt_size_bits, Entry());
+    }
+    mChildren.resize(mConfig.max_ply + 1);
+    const int saved_depth_remaining = state->mSearchDepthRemaining;
+    for (mHorizon = 1; mHorizon <= mConfig.max_ply && !mAborted; ++mHorizon) {
+      const bool prove_win = (mHorizon % 2) == 1;
+      if (!prove_win && !prove_loss) {
+        continue;
+      }
+      // Disproofs only hold for the horizon they were made under.
+      std::fill(mTable.begin(), mTable.end(), Entry());
+      mAttacker = prove_win ? state->player_to_move : state->get_enemy(state->player_to_move);
+      const Value root = mid(state, 0, PN_INF, PN_INF);
+      if (prove_win && root.phi == 0) {
+        outcome.result = ProofResult::Win;
+      } else if (!prove_win && root.delta == 0) {
+        outcome.result = ProofResult::Loss;
+      }
+      if (outcome.result != ProofResult::Unknown) {
+        outcome.move = root.best;
+        outcome.distance = root.distance;
+        break;
+      }
+    }
+    state->mSearchDepthRemaining = saved_depth_remaining;
+    outcome.nodes = mNodes;
+    outcome.elapsed_seconds = mTimer.seconds_elapsed();
+    return outcome;
+  }
+
+private:
+  static constexpr uint32_t PN_INF = 1u << 30;
+
+  struct Value {
+    uint32_t phi = 1;
+    uint32_t delta = 1;
+    int distance = 0;
+    M best{};
+  };
+
+  struct Child {
+    M move;
+    uint32_t phi;
+    uint32_t delta;
+    int distance;
+  };
+
+  struct Entry {
+    uint64_t key = 0;
+    uint32_t phi = 0;
+    uint32_t delta = 0;
+    int distance = 0;
+  };
+
+  Config mConfig;
+  const StopSignal* mStop = nullptr;
+  Timer mTimer;
+  double mMaxSeconds = 0.0;
+  int mNodes = 0;
+  bool mAborted = false;
+  int mHorizon = 0;
+  char mAttacker = 0;
+  std::vector<Entry> mTable;
+  std::vector<M> mMoves;
+  std::vector<std::vector<Child>> mChildren;  // per ply
+
+  static uint32_t clamp_pn(uint64_t value) {
+    return value >= PN_INF ? PN_INF : static_cast<uint32_t>(value);
+  }
+
+  bool aborted() {
+    if (!mAborted) {
+      mAborted = mNodes >= mConfig.max_nodes
+        || (mStop != nullptr && mStop->raised())
+        || (mMaxSeconds > 0.0 && mTimer.exceeded(mMaxSeconds));
+    }
+    return mAborted;
+  }
+
+  // A position the attacker has not won: decided against the attacker if
+  // it is to move, for it otherwise.
+  Value not_won(const S *state) const {
+    Value value;
+    const bool attacker_to_move = state->player_to_move == mAttacker;
+    value.phi = attacker_to_move ? PN_INF : 0;
+    value.delta = attacker_to_move ? 0 : PN_INF;
+    return value;
+  }
+
+  Entry* entry_for(const S *state) {
+    return &mTable[state->hash() & (mTable.size() - 1)];
+  }
+
+  // Generates every child (a proof needs all of the defender's replies) and
+  // seeds its numbers. Stops early at a child that already proves the node.
+  void expand(S *state, int ply, std::vector<Child>& children) {
+    children.clear();
+    state->fill_legal_moves(mMoves, INF);
+    for (const auto& move : mMoves) {
+      ++mNodes;
+      auto snap = state->takeSnapshot(move);
+      state->mSearchDepthRemaining = 2;  // exact make_move (see Minimax::searchMove)
+      state->make_move(move);
+      Child child{move, 1, 1, 0};
+      if (state->is_terminal()) {
+        const bool mover_won = state->get_goodness() < 0;
+        child.phi = mover_won ? PN_INF : 0;
+        child.delta = mover_won ? 0 : PN_INF;
+      } else if (ply + 1 >= mHorizon) {
+        const Value value = not_won(state);
+        child.phi = value.phi;
+        child.delta = value.delta;
+      } else {
+        const Entry* entry = entry_for(state);
+        if (entry->key == state->tt_verification_key()) {
+          child.phi = entry->phi;
+          child.delta = entry->delta;
+          child.distance = entry->distance;
+        }
+      }
+      state->restoreSnapshot(snap);
+      children.push_back(child);
+      if (child.delta == 0) {
+        break;
+      }
+    }
+  }
+
+  // Node numbers from the children; a decided node also gets the distance
+  // of its proof (shortest win, longest loss) and the move that realizes it.
+  static Value aggregate(const std::vector<Child>& children) {
+    Value value;
+    value.phi = PN_INF;
+    uint64_t delta = 0;
+    for (const auto& child : children) {
+      value.phi = std::min(value.phi, child.delta);
+      delta += child.phi;
+    }
+    value.delta = clamp_pn(delta);
+    if (value.phi == 0) {
+      value.distance = INF;
+      for (const auto& child : children) {
+        if (child.delta == 0 && child.distance + 1 < value.distance) {
+          value.distance = child.distance + 1;
+          value.best = child.move;
+        }
+      }
+    } else if (value.delta == 0) {
+      value.distance = -1;
+      for (const auto& child : children) {
+        if (child.distance + 1 > value.distance) {
+          value.distance = child.distance + 1;
+          value.best = child.move;
+        }
+      }
+    }
+    return value;
+  }
+
+  Value mid(S *state, int ply, uint32_t th_phi, uint32_t th_delta) {
+    if (ply >= mHorizon) {
+      return not_won(state);
+    }
+    std::vector<Child>& children = mChildren[ply];
+    expand(state, ply, children);
+    if (children.empty()) {
+      return not_won(state);
+    }
+    Value value;
+    while (true) {
+      value = aggregate(children);
+      if (value.phi >= th_phi || value.delta >= th_delta || aborted()) {
+        break;
+      }
+      size_t best = 0;
+      uint32_t delta2 = PN_INF;
+      for (size_t i = 1; i < children.size(); ++i) {
+        if (children[i].delta < children[best].delta) {
+          delta2 = children[best].delta;
+          best = i;
+        } else if (children[i].delta < delta2) {
+          delta2 = children[i].delta;
+        }
+      }
+      Child& child = children[best];
+      const uint32_t child_th_phi = clamp_pn(uint64_t(th_delta) + child.phi - value.delta);
+      const uint32_t child_th_delta = std::min<uint64_t>(th_phi, uint64_t(delta2) + delta2 / 4 + 1);
+      auto snap = state->takeSnapshot(child.move);
+      state->mSearchDepthRemaining = 2;
+      state->make_move(child.move);
+      const Value result = mid(state, ply + 1, child_th_phi, child_th_delta);
+      state->restoreSnapshot(snap);
+      child.phi = result.phi;
+      child.delta = result.delta;
+      child.distance = result.distance;
+    }
+    Entry* entry = entry_for(state);
+    entry->key = state->tt_verification_key();
+    entry->phi = value.phi;
+    entry->delta = value.delta;
+    entry->distance = value.distance;
+    return value;
+  }
+};
+
+// Why iterative deepening stopped (see MinimaxTimeConfig).
+enum class SearchStopReason {
+  DepthLimit,        // reached the configured max depth
+  HardDeadline,      // hard deadline hit mid-iteration
+  Stopped,           // Algorithm::stop() hit mid-iteration
+  PredictedOverrun,  // next depth predicted to overrun the hard deadline
+  SoftDeadline,      // soft deadline passed between iterations
+  StableBestMove,    // shortened soft deadline: best move stayed put
+  Proven,            // the endgame solver decided the game (MinimaxSolverConfig)
+};
+
+inline const char* search_stop_reason_name(SearchStopReason reason) {
+  switch (reason) {
+    case SearchStopReason::DepthLimit: return "depth";
+    case SearchStopReason::HardDeadline: return "hard";
+    case SearchStopReason::Stopped: return "stopped";
+    case SearchStopReason::PredictedOverrun: return "predicted";
+    case SearchStopReason::SoftDeadline: return "soft";
+    case SearchStopReason::StableBestMove: return "stable";
+    case SearchStopReason::Proven: return "proven";
+  }
+  return "unknown";
+}
+
+template<class M>
+struct MinimaxSearchStats {
+  bool completed = false;
+  int goodness = 0;
+  int nodes = 0;
+  int leafs = 0;
+  int beta_cuts = 0;
+  int cut_bf_sum = 0;
+  int tt_hits = 0;
+  int tt_exacts = 0;
+  int tt_cuts = 0;
+  int tt_size = 0;
+  int max_depth = 0;
+  int aspiration_fail_highs = 0;
+  int aspiration_fail_lows = 0;
+  int null_move_cuts = 0;
+  int probcut_cuts = 0;
+  int win_in_one_cuts = 0;
+  int quiescence_nodes = 0;
+  ProofResult proof_result = ProofResult::Unknown;
+  int proof_nodes = 0;
+  int proof_distance = 0;
+  SearchStopReason stop_reason = SearchStopReason::DepthLimit;
+  double effective_branching_factor = 0.0;
+  double elapsed_seconds = 0.0;
+  double nodes_per_second = 0.0;
+  M best_move{};
+  // Principal variation of the last completed depth, best_move first
+  // (empty when Minimax::setTrackPV is off).
+  std::vector<M> pv;
+
+  double average_cut_branching_factor() const {
+    return beta_cuts == 0 ? 0.0 : static_cast<double>(cut_bf_sum) / beta_cuts;
+  }
+
+  int aspiration_researches() const {
+    return aspiration_fail_highs + aspiration_fail_lows;
+  }
+};
+
+// One line of a multi-PV search (Minimax::setMultiPV): a root move, its
+// exact score at the last completed depth, and the principal variation
+// starting with that move.
+template<class M>
+struct MinimaxRootLine {
+  M move;
+  int score = 0;
+  std::vector<M> pv;
+};
+
+// Continuation history: how well a move has done as the reply to one
+// particular earlier move (the opponent's last move, or the side's own
+// move before that). Pairs of LegalWordIds are far too many to index
+// directly, so a pair is hashed into a table of SLOTS_PER_ID slots per
+// move id the game has (rounded up to a power of two); a collision only
+// blends two pairs' scores. The update keeps every score within
+// +-MAX_SCORE, so they fit in 16 bits.
+class ContinuationHistory {
+public:
+  static constexpr int SLOTS_PER_ID = 8;
+  static constexpr int MIN_BITS = 12;
+  static constexpr int MAX_BITS = 20;
+  static constexpr int MAX_SCORE = 16384;
+
+  // Sizes the table for ids in [0, move_ids). Clears it only if the size
+  // changes.
+  void resize(int move_ids) {
+    int bits = MIN_BITS;
+    while (bits < MAX_BITS && (1LL << bits) < static_cast<long long>(move_ids) * SLOTS_PER_ID) {
+      bits++;
+    }
+    if (bits != mBits) {
+      mBits = bits;
+      mScores.assign(size_t{1} << bits, 0);
+    }
+  }
+
+  int get(int earlier_id, int id) const {
+    return mScores[index(earlier_id, id)];
+  }
+
+  // Gravity update, as for the flat history table: a bonus counts for
+  // less the closer the score already is to MAX_SCORE.
+  void update(int earlier_id, int id, int bonus) {
+    int16_t &score = mScores[index(earlier_id, id)];
+    score = static_cast<int16_t>(score + bonus - score * std::abs(bonus) / MAX_SCORE);
+  }
+
+  // Keep 1/8 of every score (see the history aging in get_move).
+  void age() {
+    for (auto &score : mScores) score = static_cast<int16_t>(score / 8);
+  }
+
+  void clear() { std::fill(mScores.begin(), mScores.end(), 0); }
+  bool empty() const { return mScores.empty(); }
+  size_t size_bytes() const { return mScores.size() * sizeof(int16_t); }
+
+private:
+  size_t index(int earlier_id, int id) const {
+    const uint64_t pair = (static_cast<uint64_t>(static_cast<uint32_t>(earlier_id)) << 32)
+      | static_cast<uint32_t>(id);
+    return static_cast<size_t>((pair * 0x9E3779B97F4A7C15ULL) >> (64 - mBits));
+  }
+
+  std::vector<int16_t> mScores;
+  int mBits = 0;
+};
+
+// The continuation-history part of a node's ordering score: one table per
+// distance back (1 and 2 plies) and the ids of the moves at those
+// distances, negative when there is none (the root, or a null move).
+struct ContinuationContext {
+  static constexpr int PLIES = 2;
+  const ContinuationHistory *tables[PLIES] = {nullptr, nullptr};
+  int earlier_ids[PLIES] = {-1, -1};
+
+  int score(int id) const {
+    int total = 0;
+    for (int k = 0; k < PLIES; k++) {
+      if (tables[k] != nullptr && earlier_ids[k] >= 0) {
+        total += tables[k]->get(earlier_ids[k], id);
+      }
+    }
+    return total;
+  }
+};
+
+// Yields the moves of one Minimax node in search order, a stage at a
+// time, so a node that cuts off early pays only for the moves it searched:
+//   Candidates  the TT move, killers and countermove (addCandidate), each
+//               checked with isValidMove and searched before any move
+//               list exists;
+//   Remaining   every other legal move, generated into the ply's buffer
+//               and scored once, by history plus continuation history.
+//               The first LAZY_PICKS are found by a scan each; a node
+//               still searching after that is likely to search
+//               everything, so the rest is sorted in one go.
+// The order is a stable sort by descending score (history plus
+// continuation history), as one std::stable_sort of the whole list would
+// give, but it never allocates once the ply's buffers have grown.
+// At the root the move list is complete up front (it may be the cached
+// root list, whose order carries over to the next iteration), so the
+// candidates are swapped to its front and the rest is sorted in place.
+template<class S, class M>
+class MovePicker {
+public:
+  enum class Stage { Candidates, Generate, Remaining };
+  static constexpr int MAX_CANDIDATES = 4;
+  static constexpr int LAZY_PICKS = 3;
+
+  // moves is the ply's buffer, filled here unless `generated`; keys is the
+  // ply's sort-key buffer. history is indexed by LegalWordId; it and
+  // continuation (if given) are only read, at generation, when
+  // sort_by_history.
+  MovePicker(S *state, std::vector<M> &moves, std::vector<uint64_t> &keys, int max_moves,
+             bool at_root, bool generated, const int *history, int history_size,
+             bool sort_by_history, const ContinuationContext *continuation = nullptr)
+    : mState(state), mMoves(moves), mKeys(keys), mMaxMoves(max_moves), mAtRoot(at_root),
+      mGenerated(generated), mHistory(history), mHistorySize(history_size),
+      mSortByHistory(sort_by_history), mContinuation(continuation) {}
+
+  void addCandidate(const M &move) {
+    if (mNumCandidates < MAX_CANDIDATES) {
+      mCandidates[mNumCandidates++] = move;
+    }
+  }
+
+  // Generate S::fill_defending_moves instead of S::fill_legal_moves.
+  void generateDefences() { mDefending = true; }
+
+  // The stage of the move next() returned last.
+  Stage stage() const { return mStage; }
+
+  bool next(M &move) {
+    switch (mStage) {
+      case Stage::Candidates:
+        if (!mAtRoot) {
+          while (mNextCandidate < mNumCandidates) {
+            const M &candidate = mCandidates[mNextCandidate++];
+            if (!searched(candidate.mLegalWordId) && mState->isValidMove(candidate)) {
+              mSearchedIds[mNumSearched++] = candidate.mLegalWordId;
+              move = candidate;
+              return true;
+            }
+          }
+        }
+        mStage = Stage::Generate;
+        // fall through
+      case Stage::Generate:
+        generate();
+        mStage = Stage::Remaining;
+        // fall through
+      case Stage::Remaining:
+        while (mNext < static_cast<int>(mMoves.size())) {
+          int index = mNext;
+          if (mSortByHistory) {
+            const int picked = mNext - mSortFrom;
+            if (picked < LAZY_PICKS) {
+              selectBest();
+            } else if (picked == LAZY_PICKS) {
+              std::sort(mKeys.begin() + mNext, mKeys.end(), std::greater<uint64_t>());
+            }
+            index = keyIndex(mKeys[mNext]);
+          }
+          ++mNext;
+          const M &candidate = mMoves[index];
+          if (!searched(candidate.mLegalWordId)) {
+            move = candidate;
+            return true;
+          }
+        }
+        return false;
+    }
+    return false;
+  }
+
+  // Once generated: the move the full order puts first, which is the
+  // node's fallback when every move scored -INF.
+  bool hasMoves() const { return mStage == Stage::Remaining && !mMoves.empty(); }
+  const M &first() const {
+    return mSortByHistory ? mMoves[keyIndex(mKeys[0])] : mMoves[0];
+  }
+
+private:
+  // Descending keys order moves by descending score, then ascending index.
+  static uint64_t key(int score, int index) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(score) ^ 0x80000000u) << 32)
+      | (0xFFFFFFFFu - static_cast<uint32_t>(index));
+  }
+
+  static int keyIndex(uint64_t key) {
+    return static_cast<int>(0xFFFFFFFFu - static_cast<uint32_t>(key));
+  }
+
+  bool searched(int id) const {
+    for (int i = 0; i < mNumSearched; i++) {
+      if (mSearchedIds[i] == id) return true;
+    }
+    return false;
+  }
+
+  void generate() {
+    if (!mGenerated && mDefending) {
+      mState->fill_defending_moves(mMoves, mMaxMoves);
+    } else if (!mGenerated) {
+      mState->fill_legal_moves(mMoves, mMaxMoves);
+    }
+    const int size = static_cast<int>(mMoves.size());
+    if (mAtRoot) {
+      for (int c = 0; c < mNumCandidates; c++) {
+        for (int i = mSortFrom; i < size; i++) {
+          if (mMoves[i].mLegalWordId == mCandidates[c].mLegalWordId) {
+            std::swap(mMoves[mSortFrom], mMoves[i]);
+            mSortFrom++;
+            break;
+          }
+        }
+      }
+    }
+    if (!mSortByHistory) {
+      return;
+    }
+    // Scored now, not while picking: the history table changes as the
+    // node's children cut off, and the order must not.
+    mKeys.resize(size);
+    for (int i = mSortFrom; i < size; i++) {
+      const int id = mMoves[i].mLegalWordId;
+      int score = (id >= 0 && id < mHistorySize) ? mHistory[id] : 0;
+      if (mContinuation != nullptr) {
+        score += mContinuation->score(id);
+      }
+      mKeys[i] = key(score, i);
+    }
+    if (mAtRoot) {
+      std::sort(mKeys.begin() + mSortFrom, mKeys.end(), std::greater<uint64_t>());
+      permute();
+      mSortByHistory = false;
+    }
+  }
+
+  // Swaps the highest key in [mNext, end) to mNext.
+  void selectBest() {
+    int best = mNext;
+    for (int i = mNext + 1; i < static_cast<int>(mKeys.size()); i++) {
+      if (mKeys[i] > mKeys[best]) {
+        best = i;
+      }
+    }
+    std::swap(mKeys[mNext], mKeys[best]);
+  }
+
+  // Puts mMoves[mSortFrom..] in sorted key order, following each cycle of
+  // the permutation and marking its keys done.
+  void permute() {
+    const int size = static_cast<int>(mMoves.size());
+    for (int start = mSortFrom; start < size; start++) {
+      if (mKeys[start] == 0) continue;
+      const M held = mMoves[start];
+      int to = start;
+      for (;;) {
+        const int from = keyIndex(mKeys[to]);
+        mKeys[to] = 0;
+        if (from == start) {
+          mMoves[to] = held;
+          break;
+        }
+        mMoves[to] = mMoves[from];
+        to = from;
+      }
+    }
+  }
+
+  S *mState;
+  std::vector<M> &mMoves;
+  std::vector<uint64_t> &mKeys;
+  const int mMaxMoves;
+  const bool mAtRoot;
+  const bool mGenerated;
+  const int *mHistory;
+  const int mHistorySize;
+  bool mSortByHistory;
+  const ContinuationContext *mContinuation;
+  bool mDefending = false;
+  Stage mStage = Stage::Candidates;
+  M mCandidates[MAX_CANDIDATES];
+  int mNumCandidates = 0;
+  int mNextCandidate = 0;
+  int mSearchedIds[MAX_CANDIDATES];
+  int mNumSearched = 0;
+  int mNext = 0;
+  int mSortFrom = 0;
+};
+
+// Aspiration windows for iterative deepening.
+//
+// Consecutive depths usually score within a narrow band of each other, so
+// instead of (-INF, INF) each iteration from min_depth on starts with
+// (last - width, last + width) around the previous completed score. A
+// narrower window means more cutoffs. If the result falls outside it
+// (fail-low / fail-high), that side of the window is widened by
+// growth_factor and the depth is searched again; once the half-width
+// reaches max_width that side opens to ±INF.
+//
+// Example: last score 120, width 40 -> window (80, 160). Result 160
+// (fail-high) -> beta = 120 + 40*4 = 280, re-search.
+struct MinimaxAspirationConfig {
+  bool enabled = true;
+  int initial_width = 40;
+  int growth_factor = 4;
+  int max_width = 1000;
+  int min_depth = 3;
+};
+
+// Time management for iterative deepening.
+//
+// MAX_SECONDS is the hard deadline: the search polls it and throws away the
+// depth in progress when it passes. The soft deadline (setSoftSeconds,
+// defaults to the hard one) only decides whether another depth starts:
+//   - no depth starts once the soft deadline has passed;
+//   - nor when it is predicted to overrun the hard deadline. The prediction
+//     is the last depth's time times the effective branching factor: the
+//     per-depth node growth averaged (geometrically) over the last two
+//     depths, clamped to [min_ebf, max_ebf]. Per-depth cost swings a lot
+//     with pruning and TT luck; the two-depth average and a low max_ebf
+//     keep one outlier from ending the search early;
+//   - after stable_iterations consecutive depths with the same best move,
+//     the soft deadline shrinks to stable_fraction of itself;
+//   - when a depth scores score_drop or more below the previous one, the
+//     soft deadline grows by drop_extension (never past the hard one).
+struct MinimaxTimeConfig {
+  bool enabled = true;
+  double min_ebf = 1.2;
+  double max_ebf = 6.0;
+  int stable_iterations = 4;
+  double stable_fraction = 0.5;
+  int score_drop = 100;
+  double drop_extension = 2.0;
 };
 
-template<class M>
-struct MinimaxResult {
-  int goodness;
-  M best_move;
-  bool completed;
+// Selective stages that prune whole subtrees at higher depth, on top of
+// the always-on futility, reverse futility, LMR and IID. Both run only at
+// non-PV (null-window) nodes below the root with a finite beta.
+//
+// Null-move pruning: if the static eval is already >= beta, let the side
+// to move pass (S::make_null_move) and search the reply at
+// depth - 1 - null_move_reduction with a null window at beta. If even a
+// free move cannot pull the score below beta, the node fails high. Never
+// applied twice in a row, and skipped for states that cannot pass.
+//
+// ProbCut: a shallow search at depth - probcut_reduction against
+// beta + probcut_margin. A shallow score that far above beta predicts the
+// full-depth search fails high too, so the node is cut on that evidence.
+//
+// Unlike those two, the threat checks run at every interior node below
+// the root, PV or not. Win in one: a side to move that can win at once
+// (S::find_winning_move) returns the mate score without generating a
+// move. Forced defence: a side whose enemy could win at once
+// (S::enemy_threatens_win) generates only the moves that may stop it
+// (S::fill_defending_moves), and does not try a null move, which would
+// only lose to the threat.
+struct MinimaxSelectiveConfig {
+  bool null_move = true;
+  int null_move_min_depth = 3;
+  int null_move_reduction = 2;
+  bool probcut = true;
+  int probcut_min_depth = 5;
+  int probcut_reduction = 3;
+  int probcut_margin = 200;
+  bool win_in_one = true;
+  bool forced_defence = true;
 };
 
+// Quiescence search at the horizon.
+//
+// A depth-0 node in the middle of an exchange scores a board where the
+// side to move is about to take cells back. Instead of returning the
+// static eval there, keep searching capture moves only
+// (S::fill_capture_moves): the side to move may stand pat on the static
+// eval or try its best max_captures captures, up to max_ply plies deep.
+// Each horizon node gets node_budget capture nodes in total; once they are
+// spent the remaining positions stand pat.
+//
+// Off by default: almost every Wordbase move overlaps an enemy cell, so
+// the capture set is wide. On the benchmark suite (depths 1-6) it cut the
+// depth-to-depth score swing from ~345 to ~133 but cost ~6x the nodes.
+struct MinimaxQuiescenceConfig {
+  bool enabled = false;
+  int max_ply = 4;
+  int max_captures = 8;
+  int node_budget = 64;
+};
 
-class IndentingOStreambuf : public std::streambuf
-{
-  std::streambuf*     myDest;
-  bool                myIsAtStartOfLine;
-  std::string         myIndent;
-  std::ostream*       myOwner;
-protected:
-  virtual int         overflow( int ch )
-  {
-    if ( myIsAtStartOfLine && ch != '\n' ) {
-      myDest->sputn( myIndent.data(), myIndent.size() );
-    }
-    myIsAtStartOfLine = ch == '\n';
-    return myDest->sputc( ch );
-  }
-public:
-  explicit            IndentingOStreambuf(
-                                          std::streambuf* dest, int indent = 4 )
-  : myDest( dest )
-  , myIsAtStartOfLine( true )
-  , myIndent( indent, '.' )
-  , myOwner( NULL )
-  {
-  }
-  explicit            IndentingOStreambuf(
-                                          std::ostream& dest, int indent = 4 )
-  : myDest( dest.rdbuf() )
-  , myIsAtStartOfLine( true )
-  , myIndent( indent, '.' )
-  , myOwner( &dest )
-  {
-    myOwner->rdbuf( this );
-  }
-  virtual             ~IndentingOStreambuf()
-  {
-    if ( myOwner != NULL ) {
-      myOwner->rdbuf( myDest );
+// Endgame solving with ProofNumberSearch.
+//
+// When the position is a race (S::race_distance() <= race_distance: in
+// Wordbase, a side is that many rows from the enemy home row), get_move
+// first tries to prove the game, within max_nodes positions and
+// time_fraction of the soft deadline. A proven win plays the winning move
+// at once, a proven loss the longest defence; otherwise the normal search
+// runs with the time that is left. Skipped for multi-PV and restricted
+// root moves.
+struct MinimaxSolverConfig {
+  bool enabled = true;
+  int race_distance = 3;
+  int max_nodes = 200000;
+  int max_ply = 5;
+  double time_fraction = 0.25;
+};
+
+// Selective widening: each node's move cap (fill_legal_moves's
+// max_moves) from its ply, remaining depth and type, instead of the
+// engine's single max_moves. Moves come best-first by static goodness, so
+// a cap keeps the most promising ones.
+//   root       root_moves (INF: every legal move)
+//   PV node    pv_moves,  } minus taper_per_ply per ply below the first,
+//   other      cut_moves, } plus depth_bonus per remaining ply above the
+//                           last, and never below min_moves
+// The TT move, killers and countermove are searched even when the cap
+// leaves them out.
+struct MinimaxWidthConfig {
+  bool enabled = false;
+  int root_moves = INF;
+  int pv_moves = 200;
+  int cut_moves = 200;
+  int taper_per_ply = 20;
+  int depth_bonus = 0;
+  int min_moves = 40;
+
+  int cap(int ply, int depth, bool pv_node) const {
+    if (ply == 0) {
+      return root_moves;
     }
+    const long long cap = static_cast<long long>(pv_node ? pv_moves : cut_moves)
+      - static_cast<long long>(taper_per_ply) * (ply - 1)
+      + static_cast<long long>(depth_bonus) * (depth - 1);
+    return static_cast<int>(std::min<long long>(INF, std::max<long long>(min_moves, cap)));
   }
 };
 
-template<class S, class M>
-class StateUndoer {
-private:
-  S mSavedState;
-  S& mStateToUndo;
+// Where a MinimaxEngine keeps its transposition table.
+enum class MinimaxTTMode {
+  Runtime,  // setUseTranspositionTable / setSharedTT, checked at every node
+  None,     // no table
+  Local,    // its own table
+  Shared,   // setSharedTT's table, which must be set before searching
+};
 
-public:
-  // Keep undo generic unless a measured hotspot justifies per-state specialization.
-  StateUndoer(S& state, const M&) : mSavedState(state), mStateToUndo(state) {}
-  ~StateUndoer() { mStateToUndo = mSavedState; }
+// Static evaluators for MinimaxPolicy. RuntimeEvaluator means the
+// engine's constructor argument if one was given, else S::get_goodness.
+struct RuntimeEvaluator {};
+
+struct StateEvaluator {
+  template<class S>
+  int operator()(const S &state) const { return state.get_goodness(); }
 };
 
-template<class S, class M>
-struct Minimax : public Algorithm<S, M> {
-  struct SearchStats {
-    bool completed = false;
-    int goodness = 0;
-    int nodes = 0;
-    int leafs = 0;
-    int beta_cuts = 0;
-    int cut_bf_sum = 0;
-    int tt_hits = 0;
-    int tt_exacts = 0;
-    int tt_cuts = 0;
-    int tt_size = 0;
-    int max_depth = 0;
-    double elapsed_seconds = 0.0;
-    double nodes_per_second = 0.0;
-    M best_move;
+// Compile-time configuration of MinimaxEngine: how it finds its TT, the
+// static evaluator (a default-constructible functor int(const S&)), and
+// whether it writes to the trace stream at all. Fixing them turns the
+// per-node checks into constants and lets the evaluator inline.
+template<MinimaxTTMode TTMode, class Evaluator, bool Trace>
+struct MinimaxPolicy {
+  static constexpr MinimaxTTMode tt_mode = TTMode;
+  using evaluator_type = Evaluator;
+  static constexpr bool trace = Trace;
+};
 
-    double average_cut_branching_factor() const {
-      return beta_cuts == 0 ? 0.0 : static_cast<double>(cut_bf_sum) / beta_cuts;
-    }
-  };
+// Every choice left to run time: what Minimax uses.
+using RuntimeMinimaxPolicy = MinimaxPolicy<MinimaxTTMode::Runtime, RuntimeEvaluator, true>;
+
+// A single engine with its own table and the state's own evaluation.
+using LocalMinimaxPolicy = MinimaxPolicy<MinimaxTTMode::Local, StateEvaluator, false>;
+
+// E is the TT entry layout: the packed 8-byte TTEntry (default) or the
+// 16-byte WideTTEntry. Stats and config types do not depend on it. P is a
+// MinimaxPolicy; with a fixed one the matching setters
+// (setUseTranspositionTable, setTraceStream, the constructor's evaluator)
+// have no effect.
+template<class S, class M, class E = TTEntry<M>, class P = RuntimeMinimaxPolicy>
+struct MinimaxEngine : public Algorithm<S, M> {
+  using SearchStats = MinimaxSearchStats<M>;
+  using AspirationConfig = MinimaxAspirationConfig;
+  using SelectiveConfig = MinimaxSelectiveConfig;
+  using TimeConfig = MinimaxTimeConfig;
+  using QuiescenceConfig = MinimaxQuiescenceConfig;
+  using SolverConfig = MinimaxSolverConfig;
+  using WidthConfig = MinimaxWidthConfig;
+  using RootLine = MinimaxRootLine<M>;
+  using Entry = E;
 
   // --- Flat (open-addressing) transposition table ---
   //
@@ -427,18 +1843,23 @@ struct Minimax : public Algorithm<S, M> {
   // This caused ~7% of total runtime in malloc_consolidate/unlink_chunk.
   //
   // The flat table uses a fixed-size power-of-2 array with direct hash
-  // indexing: slot = hash & mask. Collisions use "always replace" policy
-  // (standard in chess engines). Benefits:
+  // indexing: bucket = hash & mask. Each bucket is one cache line of 7
+  // entries with depth/bound/age replacement (see TranspositionTable).
+  // Benefits:
   //   - Zero heap allocations during search
   //   - Single array access instead of hash bucket → linked list traversal
   //   - Better cache locality (entries are contiguous in memory)
   //
-  // Collision detection uses the verification_key stored in TTEntry
-  // (32-bit truncation of a 64-bit hash, independent from the index hash).
-  // Empty slots have verification_key == 0 (sentinel). The probability of
-  // a real position having verification_key == 0 is 2^-32, negligible.
+  // Collision detection compares the state's tt_verification_key(), a
+  // 64-bit hash independent from the index hash, with what the entry
+  // layout E keeps of it: the upper 32 bits of the packed TTEntry, or the
+  // full key XOR-verified against the data word in WideTTEntry (see their
+  // comments). An all-zero entry is empty (TTEntry::data == 0,
+  // WideTTEntry's decoded key == 0); a real position looks empty with
+  // negligible probability.
   //
-  // Table size: 2^18 = 256K entries × 8 bytes = 2 MB (fits in L3 cache).
+  // Table size: 2^18 entries' worth × 8 bytes = 2 MB (fits in L3 cache),
+  // i.e. 32K buckets × 7 usable entries.
   static constexpr size_t DEFAULT_TT_SIZE_BITS = 18;
   static constexpr size_t TT_SIZE_BITS = DEFAULT_TT_SIZE_BITS;  // legacy alias
   static constexpr size_t TT_SIZE = 1ULL << DEFAULT_TT_SIZE_BITS;
@@ -446,22 +1867,41 @@ struct Minimax : public Algorithm<S, M> {
 
   size_t mTTSizeBits;
   size_t mTTSize;
-  size_t mTTMask;
-  std::vector<TTEntry<M>> flat_tt;
+  bool mTTHugePages = true;
+  TranspositionTable<M, E> flat_tt;
   // External TT for shared-TT parallel modes (Lazy SMP, YBWC).
   // When non-null, TT operations use this instead of flat_tt.
-  TTEntry<M>* mSharedTTPtr = nullptr;
+  TranspositionTable<M, E>* mSharedTTPtr = nullptr;
+  // Whether flat_tt can ever be used.
+  static constexpr bool kOwnsTT =
+    P::tt_mode == MinimaxTTMode::Runtime || P::tt_mode == MinimaxTTMode::Local;
 
   double MAX_SECONDS;
+  double mSoftSeconds = 0.0;  // <= 0: same as MAX_SECONDS
   const int MAX_MOVES;
   std::function<int(S*)> get_goodness;
+  typename P::evaluator_type mEvaluator;
   Timer timer;
   int beta_cuts, cut_bf_sum;
   int tt_hits, tt_exacts, tt_cuts;
+  int null_move_cuts, probcut_cuts, win_in_one_cuts;
+  int quiescence_nodes;
   int nodes, leafs;
   int mMaxDepth;
   bool mUseTranspositionTable;
   std::ostream* mTraceStream;
+  // Own stop token, or one shared by all engines of a parallel search
+  // (setSharedStop); same pattern as flat_tt / mSharedTTPtr.
+  StopSignal mStopSignal;
+  StopSignal* mSharedStop = nullptr;
+  BusyMoveTable* mBusyMoves = nullptr;
+  AspirationConfig mAspiration;
+  SelectiveConfig mSelective;
+  QuiescenceConfig mQuiescence;
+  SolverConfig mSolver;
+  WidthConfig mWidth;
+  ProofNumberSearch<S, M> mProofSearch;
+  TimeConfig mTime;
   SearchStats mLastSearchStats;
   std::vector<M> mCachedRootMoves;
   bool mHasCachedRootMoves = false;
@@ -470,6 +1910,11 @@ struct Minimax : public Algorithm<S, M> {
   // Killer moves are tried right after the TT move, before heuristic ordering.
   static constexpr int MAX_PLY = 64;
   static constexpr int NUM_KILLERS = 2;
+  // prevMoveId passed below a null move; never a real LegalWordId.
+  static constexpr int NULL_MOVE_ID = -2;
+  // Shallower nodes are cheap enough to search twice, and never consult
+  // the busy-move table.
+  static constexpr int ABDADA_MIN_DEPTH = 3;
   M mKillers[MAX_PLY][NUM_KILLERS];
   bool mKillerValid[MAX_PLY][NUM_KILLERS];
 
@@ -484,9 +1929,16 @@ struct Minimax : public Algorithm<S, M> {
   int mCountermove[HISTORY_TABLE_SIZE];  // stores LegalWordId of best response
   bool mCountermoveValid[HISTORY_TABLE_SIZE];
 
+  // Continuation history, 1 and 2 plies back (see ContinuationHistory),
+  // and the id of the move that led to each ply of the current line.
+  ContinuationHistory mContinuation[ContinuationContext::PLIES];
+  int mPlyMoveIds[MAX_PLY];
+
   // Per-instance move buffers for each ply (replaces function-local static
   // depth_move_buffers[], which was not thread-safe).
   std::vector<M> mDepthMoveBuffers[MAX_PLY];
+  // Sort keys for those moves (see MovePicker).
+  std::vector<uint64_t> mDepthKeyBuffers[MAX_PLY];
   // When true, mCachedRootMoves was set externally and should not be cleared.
   bool mRootMovesLocked = false;
 
@@ -494,15 +1946,32 @@ struct Minimax : public Algorithm<S, M> {
     M move;
     int score;
   };
+  // Under PVS these are bounds for every move but the best one.
   std::vector<RootMoveScore> mCurrentRootScores;
   std::vector<RootMoveScore> mLastCompletedRootScores;
 
-  Minimax(double max_seconds = 10, int max_moves = INF, std::function<int(S*)> get_goodness = nullptr) :
+  // Multi-PV (setMultiPV): number of root lines with exact scores, the
+  // root moves the current line must skip, and the last completed depth's
+  // lines, best first.
+  int mMultiPV = 1;
+  std::vector<int> mRootExcluded;
+  std::vector<RootLine> mRootLines;
+
+  // Whether the stats carry a principal variation (setTrackPV).
+  bool mTrackPV = true;
+
+  // Lazy SMP helper diversification (see setHelperIndex); index 0 is
+  // the main thread.
+  static constexpr int HELPER_ROWS = 20;
+  static constexpr int HELPER_HISTORY_NOISE = 256;
+  int mHelperIndex = 0;
+  int mLmrShift = 0;
+  uint64_t mHelperSeed = 0;
+
+  MinimaxEngine(double max_seconds = 10, int max_moves = INF, std::function<int(S*)> get_goodness = nullptr) :
   Algorithm<S, M>(),
   mTTSizeBits(DEFAULT_TT_SIZE_BITS),
   mTTSize(1ULL << DEFAULT_TT_SIZE_BITS),
-  mTTMask((1ULL << DEFAULT_TT_SIZE_BITS) - 1),
-  flat_tt(1ULL << DEFAULT_TT_SIZE_BITS),
 	  MAX_SECONDS(max_seconds),
 	  MAX_MOVES(max_moves),
 	  get_goodness(get_goodness),
@@ -511,28 +1980,61 @@ struct Minimax : public Algorithm<S, M> {
     memset(mKillerValid, 0, sizeof(mKillerValid));
     memset(mHistory, 0, sizeof(mHistory));
     memset(mCountermoveValid, 0, sizeof(mCountermoveValid));
+    if (kOwnsTT) {
+      flat_tt.resize(DEFAULT_TT_SIZE_BITS);
+    }
   }
 
   void reset() override {
-    if (!mSharedTTPtr) {
-      memset(flat_tt.data(), 0, flat_tt.size() * sizeof(TTEntry<M>));
+    if (local_tt()) {
+      flat_tt.clear();
     }
   }
 
+  // Hard deadline: the search is abandoned when it passes.
   void setMaxSeconds(double seconds) {
     MAX_SECONDS = seconds;
   }
 
+  // Soft deadline: no new depth starts after it (see MinimaxTimeConfig).
+  // Zero or negative means "same as the hard deadline".
+  void setSoftSeconds(double seconds) {
+    mSoftSeconds = seconds;
+  }
+
+  void setTimeConfig(const TimeConfig& time) {
+    mTime = time;
+  }
+
   void setMaxDepth(int depth) {
     mMaxDepth = depth;
   }
 
+  // Resizing clears the local table; asking for the current size keeps it.
   void setTTSizeBits(size_t bits) {
+    if (bits == mTTSizeBits && (!local_tt() || !flat_tt.empty())) {
+      return;
+    }
     mTTSizeBits = bits;
     mTTSize = 1ULL << bits;
-    mTTMask = mTTSize - 1;
-    if (!mSharedTTPtr) {
-      flat_tt.assign(mTTSize, TTEntry<M>{});
+    if (local_tt()) {
+      flat_tt.resize(bits, mTTHugePages);
+    }
+  }
+
+  // Size the TT by memory: the largest power-of-two table within `megabytes`.
+  void setTTSizeMB(size_t megabytes) {
+    setTTSizeBits(TranspositionTable<M, E>::size_bits_for_mb(megabytes));
+  }
+
+  // Back the local TT with huge pages when available (default on).
+  void setTTHugePages(bool hugePages) {
+    if (hugePages == mTTHugePages) {
+      return;
+    }
+    mTTHugePages = hugePages;
+    if (local_tt()) {
+      flat_tt.resize(mTTSizeBits, mTTHugePages);
     }
   }
 
@@ -544,13 +2046,102 @@ struct Minimax : public Algorithm<S, M> {
     mTraceStream = traceStream;
   }
 
+  // A raised stop ends the search like a timeout: the last completed
+  // depth's move is returned.
+  void stop() override {
+    stop_signal().request();
+  }
+
+  void clear_stop() override {
+    stop_signal().clear();
+  }
+
+  // Poll a stop token shared with other engines instead of this engine's
+  // own. The engine raises it when its hard deadline passes, so every
+  // engine on the token stops together; the owner clears it when its
+  // search returns.
+  void setSharedStop(StopSignal* stopSignal) {
+    mSharedStop = stopSignal;
+  }
+
+  // ABDADA: share the moves being searched with the other engines on
+  // this table, and defer the ones they are busy with (see
+  // ABDADA_MIN_DEPTH). nullptr (the default) searches alone.
+  void setBusyMoveTable(BusyMoveTable* busyMoves) {
+    mBusyMoves = busyMoves;
+  }
+
+  void setAspirationConfig(const AspirationConfig& aspiration) {
+    mAspiration = aspiration;
+  }
+
+  void setSelectiveConfig(const SelectiveConfig& selective) {
+    mSelective = selective;
+  }
+
+  void setQuiescenceConfig(const QuiescenceConfig& quiescence) {
+    mQuiescence = quiescence;
+  }
+
+  // Per-node move caps; while disabled every node uses max_moves.
+  void setWidthConfig(const WidthConfig& width) {
+    mWidth = width;
+  }
+
+  void setSolverConfig(const SolverConfig& solver) {
+    mSolver = solver;
+  }
+
+  // Search the best `lines` root moves with exact scores and PVs instead
+  // of only the best one (see search_multi_pv). 1 is a normal search.
+  void setMultiPV(int lines) {
+    mMultiPV = std::max(1, lines);
+  }
+
+  // Fill SearchStats::pv after each completed depth, by following the TT's
+  // best moves from the root (see extract_pv). Costs one walk of at most
+  // depth moves per depth; off, the stats carry no line.
+  void setTrackPV(bool track) {
+    mTrackPV = track;
+  }
+
+  // Make this engine Lazy SMP helper `index` (0: the main thread, which
+  // searches as usual). Helpers on a shared TT should not all search the
+  // same tree in the same order, so helper i
+  //   - skips depths on a Stockfish-style schedule: row (i - 1) % 20
+  //     skips depth d when (d + phase) / size is odd, for the size
+  //     1,1,2,2,2,2,3,...,4 and phase 0,1,0,1,2,3,0,... of its row, so
+  //     helpers start at and work on staggered depths (never skipping
+  //     the max depth);
+  //   - reduces late moves one ply more (i % 3 == 1) or less
+  //     (i % 3 == 2) than the main thread;
+  //   - adds a per-helper random 0..255 to each history score at the
+  //     start of a search, which reorders moves with close scores.
+  void setHelperIndex(int index) {
+    mHelperIndex = std::max(0, index);
+    mLmrShift = (mHelperIndex == 0) ? 0 : (mHelperIndex % 3 == 1) ? 1 : (mHelperIndex % 3 == 2) ? -1 : 0;
+    mHelperSeed = 0x9E3779B97F4A7C15ULL * static_cast<uint64_t>(mHelperIndex + 1);
+  }
+
+  // Whether this engine skips iterative-deepening depth `depth` (see
+  // setHelperIndex).
+  bool helper_skips_depth(int depth) const {
+    static constexpr int SKIP_SIZE[HELPER_ROWS] = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+    static constexpr int SKIP_PHASE[HELPER_ROWS] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+    if (mHelperIndex == 0 || depth >= mMaxDepth) {
+      return false;
+    }
+    const int row = (mHelperIndex - 1) % HELPER_ROWS;
+    return ((depth + SKIP_PHASE[row]) / SKIP_SIZE[row]) % 2 != 0;
+  }
+
   // Use a shared transposition table (for Lazy SMP / YBWC parallel modes).
-  // Frees the local flat_tt to save memory.
-  void setSharedTT(TTEntry<M>* ptr) {
+  // Frees the local flat_tt to save memory. The owner of the shared table
+  // calls new_search() on it; engines using it do not.
+  void setSharedTT(TranspositionTable<M, E>* ptr) {
     mSharedTTPtr = ptr;
     if (ptr) {
-      flat_tt.clear();
-      flat_tt.shrink_to_fit();
+      flat_tt.release();
     }
   }
 
@@ -561,12 +2152,29 @@ struct Minimax : public Algorithm<S, M> {
     mRootMovesLocked = true;
   }
 
+  // Go back to searching every legal root move.
+  void clearRootMoves() {
+    mCachedRootMoves.clear();
+    mHasCachedRootMoves = false;
+    mRootMovesLocked = false;
+  }
+
+  const TranspositionTable<M, E>& getTranspositionTable() const {
+    return shared_tt() ? *mSharedTTPtr : flat_tt;
+  }
+
   const SearchStats& getLastSearchStats() const {
     return mLastSearchStats;
   }
 
   const std::vector<RootMoveScore>& getLastRootScores() const { return mLastCompletedRootScores; }
+  // Empty unless setMultiPV(k > 1) and at least one depth completed.
+  const std::vector<RootLine>& getRootLines() const { return mRootLines; }
 
+  // Iterative deepening from `state`. An engine reused across turns keeps
+  // what it learned: history and continuation-history scores are aged to
+  // 1/8 rather than cleared, countermoves and TT entries carry over, and
+  // only the killers start empty (reset() clears only the TT).
   M get_move(S *state) override {
     if (state->is_terminal()) {
       std::stringstream stream;
@@ -574,32 +2182,88 @@ struct Minimax : public Algorithm<S, M> {
       throw std::invalid_argument("Given state is terminal:\n" + stream.str());
     }
     timer.start();
+    const M move = iterative_deepening(state);
+    if (!mSharedStop) {
+      mStopSignal.clear();
+    }
+    return move;
+  }
+
+  // The body of get_move, which clears the stop token after it.
+  M iterative_deepening(S *state) {
     mLastSearchStats = SearchStats();
     // Clear killer moves for this search (but keep history — it persists across ID iterations).
     memset(mKillerValid, 0, sizeof(mKillerValid));
-    // Age the history table: halve all values to prevent overflow and
-    // let recent iterations dominate.
-    for (int i = 0; i < HISTORY_TABLE_SIZE; ++i) mHistory[i] >>= 1;
+    // Age the history table: keep 1/8 of the previous search's scores so
+    // they prevent overflow and still seed ordering, but this search's
+    // cutoffs quickly dominate. (Halving kept so much of the last turn's
+    // ordering that reused engines searched slower than fresh ones.)
+    for (int i = 0; i < HISTORY_TABLE_SIZE; ++i) mHistory[i] >>= 3;
+    const int move_ids = state->move_id_count();
+    if (mHelperIndex > 0) {
+      const int noisy = (move_ids > 0) ? std::min(move_ids, HISTORY_TABLE_SIZE) : HISTORY_TABLE_SIZE;
+      for (int i = 0; i < noisy; ++i) {
+        mHelperSeed ^= mHelperSeed << 13;
+        mHelperSeed ^= mHelperSeed >> 7;
+        mHelperSeed ^= mHelperSeed << 17;
+        mHistory[i] += static_cast<int>(mHelperSeed % HELPER_HISTORY_NOISE);
+      }
+    }
+    for (auto &continuation : mContinuation) {
+      continuation.resize(move_ids > 0 ? move_ids : HISTORY_TABLE_SIZE);
+      continuation.age();
+    }
+    // Entries from earlier turns stay usable but lose replacement priority.
+    if (local_tt()) {
+      flat_tt.new_search();
+    }
     if (!mRootMovesLocked) {
       mHasCachedRootMoves = false;
     }
     M best_move;
     mLastCompletedRootScores.clear();
+    mRootLines.clear();
+    bool have_last_score = false;
+    int last_score = 0;
+    int aspiration_fail_highs = 0;
+    int aspiration_fail_lows = 0;
+    const double soft_seconds = (mSoftSeconds > 0.0) ? std::min(mSoftSeconds, MAX_SECONDS) : MAX_SECONDS;
+    if (mSolver.enabled && mMultiPV == 1 && !mRootMovesLocked
+        && state->race_distance() <= mSolver.race_distance && solve_endgame(state, soft_seconds)) {
+      return mLastSearchStats.best_move;
+    }
+    int stable_depths = 0;
+    bool score_dropped = false;
+    int iteration_nodes[2] = {0, 0};  // nodes of the previous two depths
     for (int max_depth = 1; max_depth <= mMaxDepth; ++max_depth) {
-      mCurrentRootScores.clear();
+      if (helper_skips_depth(max_depth)) {
+        continue;
+      }
+      const double iteration_start = timer.seconds_elapsed();
       LOG(DEBUG) << " { ---------------------d(" << max_depth << ")------------------------------------" << std::endl;
       beta_cuts = 0;
       cut_bf_sum = 0;
       tt_hits = 0;
       tt_exacts = 0;
       tt_cuts = 0;
+      null_move_cuts = 0;
+      probcut_cuts = 0;
+      win_in_one_cuts = 0;
+      quiescence_nodes = 0;
       nodes = 0;
       leafs = 0;
       LOG(DEBUG) << *state << std::endl;
 
-      auto result = minimax(state, max_depth, -INF, INF, 0);
+      auto result = (mMultiPV > 1)
+        ? search_multi_pv(state, max_depth, aspiration_fail_highs, aspiration_fail_lows)
+        : search_root(state, max_depth, have_last_score, last_score,
+                      aspiration_fail_highs, aspiration_fail_lows);
       if (result.completed) {
+        stable_depths = (have_last_score && result.best_move == best_move) ? stable_depths + 1 : 0;
+        score_dropped = have_last_score && result.goodness <= last_score - mTime.score_drop;
         best_move = result.best_move;
+        have_last_score = true;
+        last_score = result.goodness;
         mLastCompletedRootScores = mCurrentRootScores;
         mLastSearchStats.completed = true;
         mLastSearchStats.goodness = result.goodness;
@@ -612,11 +2276,21 @@ struct Minimax : public Algorithm<S, M> {
         mLastSearchStats.tt_cuts = tt_cuts;
         mLastSearchStats.tt_size = mTTSize;
         mLastSearchStats.max_depth = max_depth;
+        mLastSearchStats.aspiration_fail_highs = aspiration_fail_highs;
+        mLastSearchStats.aspiration_fail_lows = aspiration_fail_lows;
+        mLastSearchStats.null_move_cuts = null_move_cuts;
+        mLastSearchStats.probcut_cuts = probcut_cuts;
+        mLastSearchStats.win_in_one_cuts = win_in_one_cuts;
+        mLastSearchStats.quiescence_nodes = quiescence_nodes;
         mLastSearchStats.elapsed_seconds = timer.seconds_elapsed();
         mLastSearchStats.nodes_per_second = mLastSearchStats.elapsed_seconds == 0.0 ? 0.0 : nodes / mLastSearchStats.elapsed_seconds;
         mLastSearchStats.best_move = best_move;
-        if (mTraceStream != nullptr) {
-          *mTraceStream << "goodness: " << result.goodness
+        if (mTrackPV) {
+          mLastSearchStats.pv = (mMultiPV > 1 && !mRootLines.empty())
+            ? mRootLines[0].pv : extract_pv(state, best_move, max_depth);
+        }
+        if (std::ostream* trace = trace_stream()) {
+          *trace << "goodness: " << result.goodness
             << " time: " << timer
             << " move: " << best_move
             << " nodes: " << nodes
@@ -626,41 +2300,192 @@ struct Minimax : public Algorithm<S, M> {
             << " tt_hits: " << tt_hits
             << " tt_exacts: " << tt_exacts
             << " tt_cuts: " << tt_cuts
+            << " null_move_cuts: " << null_move_cuts
+            << " probcut_cuts: " << probcut_cuts
+            << " win_in_one_cuts: " << win_in_one_cuts
+            << " quiescence_nodes: " << quiescence_nodes
             << " tt_size: " << TT_SIZE
             << " max_depth: " << max_depth << std::endl;
         }
       }
       LOG(DEBUG) << " } ---------------------d(" << max_depth << ")------------------------------------" << std::endl;
-      if (timer.exceeded(MAX_SECONDS)) {
+      if (out_of_time()) {
+        mLastSearchStats.stop_reason = stop_signal().requested()
+          ? SearchStopReason::Stopped : SearchStopReason::HardDeadline;
         break;
       }
-      if (mTraceStream != nullptr) {
-        *mTraceStream << (double) nodes / timer.seconds_elapsed() << " nodes/s" << std::endl;
+      if (mTime.enabled && max_depth < mMaxDepth && should_stop_deepening(
+            iteration_start, iteration_nodes, soft_seconds, stable_depths, score_dropped)) {
+        break;
+      }
+      iteration_nodes[1] = iteration_nodes[0];
+      iteration_nodes[0] = nodes;
+      if (std::ostream* trace = trace_stream()) {
+        *trace << (double) nodes / timer.seconds_elapsed() << " nodes/s" << std::endl;
       }
     }
     return best_move;
   }
 
+  // Endgame solver (see MinimaxSolverConfig). Records the attempt in the
+  // stats; on a proof also fills in the result and returns true.
+  bool solve_endgame(S *state, double soft_seconds) {
+    ProofNumberConfig config = mProofSearch.getConfig();
+    config.max_nodes = mSolver.max_nodes;
+    config.max_ply = std::min(mSolver.max_ply, MAX_PLY - 1);
+    mProofSearch.setConfig(config);
+    mProofSearch.setStop(&stop_signal());
+    const auto outcome = mProofSearch.solve(state, std::min(MAX_SECONDS, soft_seconds * mSolver.time_fraction));
+    mLastSearchStats.proof_result = outcome.result;
+    mLastSearchStats.proof_nodes = outcome.nodes;
+    mLastSearchStats.proof_distance = outcome.distance;
+    if (std::ostream* trace = trace_stream()) {
+      *trace << "proof: " << proof_result_name(outcome.result)
+        << " distance: " << outcome.distance
+        << " nodes: " << outcome.nodes
+        << " time: " << outcome.elapsed_seconds << "s" << std::endl;
+    }
+    if (outcome.result == ProofResult::Unknown) {
+      return false;
+    }
+    const int mate = INF - outcome.distance;
+    mLastSearchStats.completed = true;
+    mLastSearchStats.goodness = (outcome.result == ProofResult::Win) ? mate : -mate;
+    mLastSearchStats.nodes = outcome.nodes;
+    mLastSearchStats.max_depth = outcome.distance;
+    mLastSearchStats.best_move = outcome.move;
+    if (mTrackPV) {
+      mLastSearchStats.pv = {outcome.move};
+    }
+    mLastSearchStats.stop_reason = SearchStopReason::Proven;
+    mLastSearchStats.elapsed_seconds = timer.seconds_elapsed();
+    mLastSearchStats.nodes_per_second = mLastSearchStats.elapsed_seconds == 0.0
+      ? 0.0 : outcome.nodes / mLastSearchStats.elapsed_seconds;
+    return true;
+  }
+
+  // Search one iterative-deepening iteration from the root, using an
+  // aspiration window around last_score when configured (see
+  // AspirationConfig). Re-searches until the score lands strictly inside
+  // the window or the search runs out of time. Fail counts accumulate into
+  // the caller's counters so they cover the whole get_move call.
+  MinimaxResult<M> search_root(S *state, int depth, bool have_last_score, int last_score,
+                               int &fail_highs, int &fail_lows) {
+    int alpha = -INF;
+    int beta = INF;
+    int low_width = mAspiration.initial_width;
+    int high_width = mAspiration.initial_width;
+    // Mate scores are not centered in any useful band; search those fully.
+    if (mAspiration.enabled && have_last_score && depth >= mAspiration.min_depth
+        && last_score > -INF + 1000 && last_score < INF - 1000) {
+      alpha = last_score - low_width;
+      beta = last_score + high_width;
+    }
+    while (true) {
+      mCurrentRootScores.clear();
+      auto result = minimax(state, depth, alpha, beta, 0);
+      if (!result.completed) {
+        return result;
+      }
+      const int growth = std::max(2, mAspiration.growth_factor);
+      if (result.goodness <= alpha && alpha != -INF) {
+        ++fail_lows;
+        low_width = std::min(low_width, mAspiration.max_width) * growth;
+        alpha = (low_width >= mAspiration.max_width || static_cast<long long>(last_score) - low_width <= -INF + 1000)
+          ? -INF : last_score - low_width;
+      } else if (result.goodness >= beta && beta != INF) {
+        ++fail_highs;
+        high_width = std::min(high_width, mAspiration.max_width) * growth;
+        beta = (high_width >= mAspiration.max_width || static_cast<long long>(last_score) + high_width >= INF - 1000)
+          ? INF : last_score + high_width;
+      } else {
+        return result;
+      }
+    }
+  }
+
+  // Multi-PV iteration: line k is a search_root with the k moves already
+  // found excluded at the root, so its result is the k-th best move with
+  // an exact score. Each line's aspiration window is centered on the same
+  // line's score from the previous depth. All lines run on this engine, so
+  // they share its TT, killers and history: after the first line most of
+  // the tree below the other root moves is already in the table. The root
+  // position itself is neither probed nor stored while moves are excluded.
+  // The depth only counts as completed when every line finishes; the
+  // result is line 0's.
+  MinimaxResult<M> search_multi_pv(S *state, int depth, int &fail_highs, int &fail_lows) {
+    int root_moves;
+    if (mHasCachedRootMoves) {
+      root_moves = static_cast<int>(mCachedRootMoves.size());
+    } else {
+      state->fill_legal_moves(mDepthMoveBuffers[0], move_cap(0, depth, true));
+      root_moves = static_cast<int>(mDepthMoveBuffers[0].size());
+    }
+    const int num_lines = std::min(mMultiPV, root_moves);
+    std::vector<RootLine> lines;
+    MinimaxResult<M> best;
+    mRootExcluded.clear();
+    for (int k = 0; k < num_lines; ++k) {
+      const bool have_last = k < static_cast<int>(mRootLines.size());
+      auto result = search_root(state, depth, have_last, have_last ? mRootLines[k].score : 0,
+                                fail_highs, fail_lows);
+      if (!result.completed) {
+        mRootExcluded.clear();
+        return result;
+      }
+      if (k == 0) {
+        best = result;
+      }
+      lines.push_back({result.best_move, result.goodness, {}});
+      mRootExcluded.push_back(result.best_move.mLegalWordId);
+    }
+    mRootExcluded.clear();
+    mCurrentRootScores.clear();
+    for (auto& line : lines) {
+      line.pv = extract_pv(state, line.move, depth);
+      mCurrentRootScores.push_back({line.move, line.score});
+    }
+    mRootLines = std::move(lines);
+    return best;
+  }
+
+  // Principal variation starting with `first`: follow the TT's best moves
+  // for at most max_length moves. The walk stops at a terminal position, a
+  // missing entry or a stored move that isValidMove rejects, so a hash
+  // collision shortens the line instead of corrupting it.
+  std::vector<M> extract_pv(S *state, const M &first, int max_length) {
+    std::vector<M> pv{first};
+    S walk = state->clone();
+    walk.make_move(first);
+    E entry;
+    while (static_cast<int>(pv.size()) < max_length && !walk.is_terminal()
+           && use_tt() && get_tt_entry(&walk, entry)
+           && walk.isValidMove(entry.get_move())) {
+      pv.push_back(entry.get_move());
+      walk.make_move(entry.get_move());
+    }
+    return pv;
+  }
+
   // Find Minimax value of the given tree,
   // Minimax value lies within a range of [alpha; beta] window.
   // Whenever alpha >= beta, further checks of children in a node can be pruned.
   MinimaxResult<M> minimax(S *state, int depth, int alpha, int beta, int indent, int prevMoveId = -1) {
     ++nodes;
+    mPlyMoveIds[indent] = prevMoveId;
     const int alpha_original = alpha;
 
     M best_move;
     if (depth == 0 || state->is_terminal()) {
       ++leafs;
-      int goodness = get_goodness ? get_goodness(state) : state->get_goodness();
-      // Prefer faster wins / slower losses: adjust terminal values by ply
-      // so the engine fights harder in lost positions (delays loss, creates
-      // complications) rather than treating all forced losses as identical.
-      if (goodness >= INF - 1000) goodness = INF - indent;
-      else if (goodness <= -INF + 1000) goodness = -(INF - indent);
-      return {goodness, best_move, false};
+      if (mQuiescence.enabled && !state->is_terminal()) {
+        int budget = mQuiescence.node_budget;
+        return {quiescence(state, alpha, beta, indent, 0, budget), best_move, false};
+      }
+      return {leaf_goodness(state, indent), best_move, false};
     }
 
-    TTEntry<M> entry;
+    E entry;
     bool entry_found = get_tt_entry(state, entry);
     // Validate that the stored move is still legal for this position.
     // Hash/verification collisions or cross-turn TT reuse can produce
@@ -668,8 +2493,11 @@ struct Minimax : public Algorithm<S, M> {
     // If isValidMove becomes a bottleneck, we could restrict this check
     // to EXACT_VALUE entries only (those skip the search entirely).
     // Bounds entries with wrong values just cause suboptimal pruning.
-    if (mUseTranspositionTable && entry_found && entry.get_depth() >= depth
-        && state->isValidMove(entry.get_move())) {
+    // The root's entry describes all of its moves, so it cannot answer a
+    // multi-PV line that excludes some (see search_multi_pv).
+    const bool root_excludes = indent == 0 && !mRootExcluded.empty();
+    if (use_tt() && entry_found && entry.get_depth() >= depth
+        && !root_excludes && state->isValidMove(entry.get_move())) {
       ++tt_hits;
       if (entry.get_value_type() == TTEntryType::EXACT_VALUE) {
         ++tt_exacts;
@@ -687,6 +2515,51 @@ struct Minimax : public Algorithm<S, M> {
       }
     }
 
+    const bool nonPVNode = indent > 0 && beta - alpha == 1
+      && beta > -INF + 1000 && beta < INF - 1000;
+
+    // Threat checks (see MinimaxSelectiveConfig).
+    bool threatened = false;
+    if (indent > 0) {
+      if (mSelective.win_in_one && state->find_winning_move(best_move)) {
+        ++win_in_one_cuts;
+        return {INF - (indent + 1), best_move, true};
+      }
+      threatened = mSelective.forced_defence && state->enemy_threatens_win();
+    }
+
+    // Null-move pruning (see MinimaxSelectiveConfig).
+    if (mSelective.null_move && nonPVNode && !threatened && prevMoveId != NULL_MOVE_ID
+        && depth >= mSelective.null_move_min_depth) {
+      int staticEval = evaluate(state);
+      if (staticEval >= beta && state->make_null_move()) {
+        const int savedDepthRemaining = state->mSearchDepthRemaining;
+        state->mSearchDepthRemaining = depth;
+        auto reply = minimax(state, std::max(0, depth - 1 - mSelective.null_move_reduction),
+                             -beta, -beta + 1, indent + 1, NULL_MOVE_ID);
+        state->undo_null_move();
+        state->mSearchDepthRemaining = savedDepthRemaining;
+        if (-reply.goodness >= beta) {
+          ++null_move_cuts;
+          // A pass proves a bound, not a forced win: don't return mate scores.
+          return {-reply.goodness >= INF - 1000 ? beta : -reply.goodness, best_move, true};
+        }
+      }
+    }
+
+    // ProbCut (see MinimaxSelectiveConfig).
+    if (mSelective.probcut && nonPVNode && depth >= mSelective.probcut_min_depth
+        && beta + mSelective.probcut_margin < INF - 1000) {
+      const int probcutBeta = beta + mSelective.probcut_margin;
+      auto shallow = minimax(state, depth - mSelective.probcut_reduction,
+                             probcutBeta - 1, probcutBeta, indent, prevMoveId);
+      if (shallow.goodness >= probcutBeta) {
+        ++probcut_cuts;
+        return {shallow.goodness, shallow.best_move, true};
+      }
+      entry_found = get_tt_entry(state, entry);
+    }
+
     // Internal Iterative Deepening: if no TT move exists at a node
     // with enough remaining depth, do a shallow search to find a good
     // move to try first (which also populates the TT for PVS).
@@ -700,9 +2573,11 @@ struct Minimax : public Algorithm<S, M> {
     static constexpr int FUTILITY_MARGIN_D2 = 500;
     static constexpr int RFP_MARGIN_D1 = 100;
     static constexpr int RFP_MARGIN_D2 = 300;
+    // Continuation score below which LMR reduces a move one more ply.
+    static constexpr int CONTINUATION_LMR_MARGIN = 400;
     bool canFutilityPrune = false;
     if (indent > 0 && depth <= 2 && alpha > -INF + 1000 && beta < INF - 1000) {
-      int staticEval = get_goodness ? get_goodness(state) : state->get_goodness();
+      int staticEval = evaluate(state);
       // Reverse futility pruning: if eval is far above beta, prune
       // the entire node — no move can make it worse enough.
       int rfpMargin = (depth == 1) ? RFP_MARGIN_D1 : RFP_MARGIN_D2;
@@ -719,19 +2594,40 @@ struct Minimax : public Algorithm<S, M> {
     bool completed = true;
     bool found_best_move = false;
 
-    // Track move IDs searched in early stages (to skip duplicates later).
-    int staged_ids[5];
-    int num_staged = 0;
     int moves_searched = 0;
     bool search_stopped = false;
 
+    // This node's continuation-history context, and the first MAX_TRIED
+    // moves searched without a cutoff, which lose continuation score if a
+    // later move cuts off.
+    ContinuationContext continuation;
+    for (int k = 0; k < ContinuationContext::PLIES && k <= indent; k++) {
+      continuation.tables[k] = &mContinuation[k];
+      continuation.earlier_ids[k] = mPlyMoveIds[indent - k];
+    }
+    static constexpr int MAX_TRIED = 32;
+    int tried_ids[MAX_TRIED];
+    int num_tried = 0;
+    // Moves deferred by ABDADA, with their LMR reductions.
+    static constexpr int MAX_DEFERRED = 32;
+    std::pair<M, int> deferred[MAX_DEFERRED];
+    int num_deferred = 0;
+
     // Common logic for searching one move. Uses lightweight snapshot
     // (excludes mPlayedWords ~1KB) instead of full state copy.
     // reduction: number of plies to reduce depth by (0 = full search).
+    // With quiescence on, a horizon child searches on, so the move into it
+    // must not take make_move's shallow-depth shortcuts.
+    const int child_depth_remaining = mQuiescence.enabled ? depth + 1 : depth;
     auto searchMove = [&](const M& move, int reduction = 0) {
       auto snap = state->takeSnapshot(move);
-      state->mSearchDepthRemaining = depth;
+      state->mSearchDepthRemaining = child_depth_remaining;
       state->make_move(move);
+      // The child's hash is final now; start loading its TT bucket while the
+      // child sets up. Depth-1 children are leaves and never probe.
+      if (use_tt() && depth > 1) {
+        tt().prefetch(state->hash());
+      }
 
       int goodness;
       // PVS: first move gets full window; subsequent moves get null window.
@@ -758,7 +2654,10 @@ struct Minimax : public Algorithm<S, M> {
 	mCurrentRootScores.push_back({move, goodness});
       }
 
-      if ((nodes & 4095) == 0 && timer.exceeded(MAX_SECONDS)) {
+      // The stop token is one relaxed load per node, so a stop raised by
+      // another thread lands within a few nodes; the clock is read only
+      // every 4096 nodes.
+      if (stop_signal().raised() || ((nodes & 4095) == 0 && out_of_time())) {
 	completed = false;
 	search_stopped = true;
       } else if (goodness > max_goodness) {
@@ -787,202 +2686,290 @@ struct Minimax : public Algorithm<S, M> {
 	    int bonus = depth * depth;
 	    int& e = mHistory[id];
 	    e += bonus - e * bonus / 16384;
+	    // Continuation history: a bonus for this reply, a malus for
+	    // the replies tried before it here.
+	    for (int k = 0; k < ContinuationContext::PLIES; k++) {
+	      if (continuation.earlier_ids[k] >= 0) {
+		mContinuation[k].update(continuation.earlier_ids[k], id, bonus);
+		for (int t = 0; t < num_tried; t++) {
+		  mContinuation[k].update(continuation.earlier_ids[k], tried_ids[t], -bonus);
+		}
+	      }
+	    }
 	  }
 	  search_stopped = true;
 	}
       }
 
+      if (!search_stopped && num_tried < MAX_TRIED) {
+	tried_ids[num_tried++] = move.mLegalWordId;
+      }
+
       // Restore state: snapshot clears changed played-word bits, then restores
       // grid, hash, bitboards, player, etc.
       state->restoreSnapshot(snap);
       if (!search_stopped && alpha < max_goodness) alpha = max_goodness;
     };
 
-    // --- Staged move generation (non-root nodes only) ---
-    // Try TT move, killers, and countermove BEFORE generating the full
-    // move list. This avoids the expensive fill_legal_moves call (~37%
-    // of runtime) at nodes where a privileged move causes a cutoff.
-    if (indent > 0) {
-      // Stage 1: TT move.
-      if (entry_found && state->isValidMove(entry.get_move())) {
-	staged_ids[num_staged++] = entry.get_move().mLegalWordId;
-	searchMove(entry.get_move());
-      }
-
-      // Stage 2: Killer moves.
-      for (int k = 0; k < NUM_KILLERS && !search_stopped && indent < MAX_PLY; k++) {
-	if (mKillerValid[indent][k]) {
-	  int kid = mKillers[indent][k].mLegalWordId;
-	  bool dup = false;
-	  for (int j = 0; j < num_staged; j++)
-	    if (staged_ids[j] == kid) { dup = true; break; }
-	  if (!dup && state->isValidMove(mKillers[indent][k])) {
-	    staged_ids[num_staged++] = kid;
-	    searchMove(mKillers[indent][k]);
-	  }
-	}
-      }
-
-      // Stage 3: Countermove.
-      if (!search_stopped && prevMoveId >= 0 && prevMoveId < HISTORY_TABLE_SIZE
-	  && mCountermoveValid[prevMoveId]) {
-	int cmId = mCountermove[prevMoveId];
-	bool dup = false;
-	for (int j = 0; j < num_staged; j++)
-	  if (staged_ids[j] == cmId) { dup = true; break; }
-	if (!dup) {
-	  M cmMove(cmId);
-	  if (state->isValidMove(cmMove)) {
-	    staged_ids[num_staged++] = cmId;
-	    searchMove(cmMove);
-	  }
-	}
+    // Moves in stages (see MovePicker): at non-root nodes the TT move,
+    // killers and countermove are searched before the expensive
+    // fill_legal_moves call (~37% of runtime), which a cutoff among them
+    // skips; the rest come in history order from depth 3 up.
+    const bool at_root = indent == 0;
+    MovePicker<S, M> picker(state,
+                            (at_root && mHasCachedRootMoves) ? mCachedRootMoves : mDepthMoveBuffers[indent],
+                            mDepthKeyBuffers[indent], move_cap(indent, depth, !nonPVNode),
+                            at_root, at_root && mHasCachedRootMoves,
+                            mHistory, HISTORY_TABLE_SIZE, depth >= 3, &continuation);
+    if (threatened) {
+      picker.generateDefences();
+    }
+    if (entry_found) {
+      picker.addCandidate(entry.get_move());
+    }
+    for (int k = 0; k < NUM_KILLERS && indent < MAX_PLY; k++) {
+      if (mKillerValid[indent][k]) {
+	picker.addCandidate(mKillers[indent][k]);
       }
     }
+    if (prevMoveId >= 0 && prevMoveId < HISTORY_TABLE_SIZE
+	&& mCountermoveValid[prevMoveId]) {
+      picker.addCandidate(M(mCountermove[prevMoveId]));
+    }
 
-    // Stage 4: Generate all remaining moves (skipped if a staged move caused cutoff).
-    if (!search_stopped) {
-      std::vector<M>& legal_moves = (indent == 0 && mHasCachedRootMoves)
-	? mCachedRootMoves
-	: mDepthMoveBuffers[indent];
-      if (!(indent == 0 && mHasCachedRootMoves)) {
-	state->fill_legal_moves(legal_moves, MAX_MOVES);
+    M move;
+    while (!search_stopped && picker.next(move)) {
+      if (picker.stage() == MovePicker<S, M>::Stage::Candidates) {
+	searchMove(move);
+	continue;
+      }
+      if (root_excludes && std::find(mRootExcluded.begin(), mRootExcluded.end(),
+				     move.mLegalWordId) != mRootExcluded.end()) {
+	continue;
       }
 
-      // At root: promote TT/killers/CM to front (no staging at root).
-      if (indent == 0 && !legal_moves.empty()) {
-	int front = 0;
-	if (mUseTranspositionTable && entry_found && state->isValidMove(entry.get_move())) {
-	  for (int i = front; i < static_cast<int>(legal_moves.size()); i++) {
-	    if (legal_moves[i].mLegalWordId == entry.get_move().mLegalWordId) {
-	      std::swap(legal_moves[front], legal_moves[i]);
-	      front++;
-	      break;
-	    }
-	  }
-	}
-	for (int k = 0; k < NUM_KILLERS && indent < MAX_PLY; k++) {
-	  if (mKillerValid[indent][k]) {
-	    int killerId = mKillers[indent][k].mLegalWordId;
-	    for (int i = front; i < static_cast<int>(legal_moves.size()); i++) {
-	      if (legal_moves[i].mLegalWordId == killerId) {
-		std::swap(legal_moves[front], legal_moves[i]);
-		front++;
-		break;
-	      }
-	    }
-	  }
-	}
-	if (prevMoveId >= 0 && prevMoveId < HISTORY_TABLE_SIZE
-	    && mCountermoveValid[prevMoveId]) {
-	  int cmId = mCountermove[prevMoveId];
-	  for (int i = front; i < static_cast<int>(legal_moves.size()); i++) {
-	    if (legal_moves[i].mLegalWordId == cmId) {
-	      std::swap(legal_moves[front], legal_moves[i]);
-	      front++;
-	      break;
-	    }
-	  }
-	}
-	if (depth >= 3 && front < static_cast<int>(legal_moves.size())) {
-	  const int* hist = mHistory;
-	  std::stable_sort(legal_moves.begin() + front, legal_moves.end(),
-	    [hist](const M& a, const M& b) {
-	      int ha = (a.mLegalWordId >= 0 && a.mLegalWordId < HISTORY_TABLE_SIZE)
-		       ? hist[a.mLegalWordId] : 0;
-	      int hb = (b.mLegalWordId >= 0 && b.mLegalWordId < HISTORY_TABLE_SIZE)
-		       ? hist[b.mLegalWordId] : 0;
-	      return ha > hb;
-	    });
-	}
+      // Futility pruning: skip late moves at shallow depth when
+      // static eval + margin is below alpha. Always search at least
+      // 2 non-staged moves before pruning.
+      if (canFutilityPrune && moves_searched >= 2) {
+	break;
       }
 
-      // At non-root: sort by history (staged moves will be skipped).
-      if (indent > 0 && depth >= 3 && !legal_moves.empty()) {
-	const int* hist = mHistory;
-	std::stable_sort(legal_moves.begin(), legal_moves.end(),
-	  [hist](const M& a, const M& b) {
-	    int ha = (a.mLegalWordId >= 0 && a.mLegalWordId < HISTORY_TABLE_SIZE)
-		     ? hist[a.mLegalWordId] : 0;
-	    int hb = (b.mLegalWordId >= 0 && b.mLegalWordId < HISTORY_TABLE_SIZE)
-		     ? hist[b.mLegalWordId] : 0;
-	    return ha > hb;
-	  });
-      }
-
-      for (const auto& move : legal_moves) {
-	// Skip moves already searched in stages 1-3.
-	bool dup = false;
-	for (int j = 0; j < num_staged; j++) {
-	  if (staged_ids[j] == move.mLegalWordId) { dup = true; break; }
-	}
-	if (dup) continue;
+      // Late Move Reduction: moves searched after the first few at
+      // non-root nodes with sufficient depth are searched at reduced
+      // depth first. If the reduced search beats alpha, re-search at
+      // full depth (handled inside searchMove).
+      int reduction = 0;
+      if (indent > 0 && depth >= 3 && moves_searched >= 3) {
+	// Base reduction: 1 ply. Increase for later moves.
+	reduction = 1;
+	if (moves_searched >= 8) reduction = 2;
+	if (moves_searched >= 20 && depth >= 5) reduction = 3;
+	// A move that keeps failing as a reply to these earlier moves is
+	// reduced one more ply.
+	if (continuation.score(move.mLegalWordId) <= -CONTINUATION_LMR_MARGIN) reduction++;
+	reduction += mLmrShift;
+	// Don't reduce below depth 1.
+	if (reduction >= depth - 1) reduction = depth - 2;
+	if (reduction < 0) reduction = 0;
+      }
 
-	// Futility pruning: skip late moves at shallow depth when
-	// static eval + margin is below alpha. Always search at least
-	// 2 non-staged moves before pruning.
-	if (canFutilityPrune && moves_searched >= 2) {
+      // ABDADA (see setBusyMoveTable): after the first move, a move that
+      // another thread is searching waits until the node's other moves
+      // are done.
+      if (mBusyMoves != nullptr && depth >= ABDADA_MIN_DEPTH) {
+	const uint64_t key = BusyMoveTable::key(state->hash(), move.mLegalWordId);
+	if (moves_searched > 0 && num_deferred < MAX_DEFERRED && mBusyMoves->busy(key)) {
+	  deferred[num_deferred++] = {move, reduction};
 	  continue;
 	}
-
-	// Late Move Reduction: moves searched after the first few at
-	// non-root nodes with sufficient depth are searched at reduced
-	// depth first. If the reduced search beats alpha, re-search at
-	// full depth (handled inside searchMove).
-	int reduction = 0;
-	if (indent > 0 && depth >= 3 && moves_searched >= 3) {
-	  // Base reduction: 1 ply. Increase for later moves.
-	  reduction = 1;
-	  if (moves_searched >= 8) reduction = 2;
-	  if (moves_searched >= 20 && depth >= 5) reduction = 3;
-	  // Don't reduce below depth 1.
-	  if (reduction >= depth - 1) reduction = depth - 2;
-	  if (reduction < 0) reduction = 0;
-	}
+	mBusyMoves->enter(key);
 	searchMove(move, reduction);
-	if (search_stopped) break;
+	mBusyMoves->leave(key);
+	continue;
       }
+      searchMove(move, reduction);
+    }
+    for (int i = 0; i < num_deferred && !search_stopped; i++) {
+      searchMove(deferred[i].first, deferred[i].second);
+    }
 
-      if (!found_best_move && !legal_moves.empty()) {
-	// All moves scored equally (e.g., all forced loss). Pick the first
-	// in move ordering (best heuristic) rather than random — gives
-	// practical chances against human opponents who may miss the win.
-	best_move = legal_moves[0];
+    if (!found_best_move && picker.hasMoves()) {
+      // All moves scored equally (e.g., all forced loss). Pick the first
+      // in move ordering (best heuristic) rather than random — gives
+      // practical chances against human opponents who may miss the win.
+      best_move = picker.first();
+    } else if (threatened && !found_best_move && completed) {
+      // Nothing stops the enemy's win: every move loses next ply.
+      state->fill_legal_moves(mDepthMoveBuffers[indent], 1);
+      if (!mDepthMoveBuffers[indent].empty()) {
+        best_move = mDepthMoveBuffers[indent][0];
+        max_goodness = -(INF - (indent + 2));
       }
     }
 
-    if (mUseTranspositionTable && completed) {
+    if (use_tt() && completed && !root_excludes) {
       update_tt(state, alpha_original, beta, max_goodness, best_move, depth);
     }
     return {max_goodness, best_move, completed};
   }
 
+  // Static eval of a leaf. Prefer faster wins / slower losses: adjust
+  // terminal values by ply so the engine fights harder in lost positions
+  // (delays loss, creates complications) rather than treating all forced
+  // losses as identical.
+  int leaf_goodness(S *state, int indent) {
+    int goodness = evaluate(state);
+    if (goodness >= INF - 1000) goodness = INF - indent;
+    else if (goodness <= -INF + 1000) goodness = -(INF - indent);
+    return goodness;
+  }
+
+  // Capture-only search below the horizon (see MinimaxQuiescenceConfig).
+  // Fail-soft: returns the stand-pat eval or the best capture line.
+  // budget is shared by the whole quiescence tree under one horizon node.
+  int quiescence(S *state, int alpha, int beta, int indent, int qply, int &budget) {
+    const int stand_pat = leaf_goodness(state, indent);
+    if (stand_pat >= beta || state->is_terminal() || qply >= mQuiescence.max_ply
+        || budget <= 0 || indent + 1 >= MAX_PLY) {
+      return stand_pat;
+    }
+    if (stand_pat > alpha) alpha = stand_pat;
+    int best = stand_pat;
+    std::vector<M>& captures = mDepthMoveBuffers[indent];
+    state->fill_capture_moves(captures, mQuiescence.max_captures);
+    for (const auto& move : captures) {
+      if (budget <= 0) break;
+      --budget;
+      ++nodes;
+      ++quiescence_nodes;
+      auto snap = state->takeSnapshot(move);
+      state->mSearchDepthRemaining = 2;  // keep make_move exact (see searchMove)
+      state->make_move(move);
+      const int goodness = -quiescence(state, -beta, -alpha, indent + 1, qply + 1, budget);
+      state->restoreSnapshot(snap);
+      if (goodness > best) {
+        best = goodness;
+        if (best >= beta) break;
+        if (best > alpha) alpha = best;
+      }
+    }
+    return best;
+  }
+
   Random random;
 
-  // Look up a position in the flat transposition table.
+  // Between iterations: decide whether the next depth is worth starting
+  // (see MinimaxTimeConfig). Records the reason in mLastSearchStats.
+  bool should_stop_deepening(double iteration_start, const int iteration_nodes[2],
+                             double soft_seconds, int stable_depths, bool score_dropped) {
+    const double elapsed = timer.seconds_elapsed();
+    double target = soft_seconds;
+    if (score_dropped) {
+      target = std::min(MAX_SECONDS, soft_seconds * mTime.drop_extension);
+    } else if (stable_depths >= mTime.stable_iterations) {
+      target = soft_seconds * mTime.stable_fraction;
+    }
+    if (elapsed >= target) {
+      mLastSearchStats.stop_reason = (target < soft_seconds)
+        ? SearchStopReason::StableBestMove : SearchStopReason::SoftDeadline;
+      return true;
+    }
+    double growth = 0.0;
+    if (iteration_nodes[1] > 0) {
+      growth = std::sqrt(static_cast<double>(nodes) / iteration_nodes[1]);
+    } else if (iteration_nodes[0] > 0) {
+      growth = static_cast<double>(nodes) / iteration_nodes[0];
+    }
+    if (growth > 0.0) {
+      const double ebf = std::min(mTime.max_ebf, std::max(mTime.min_ebf, growth));
+      mLastSearchStats.effective_branching_factor = ebf;
+      if (elapsed + (elapsed - iteration_start) * ebf > MAX_SECONDS) {
+        mLastSearchStats.stop_reason = SearchStopReason::PredictedOverrun;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  StopSignal& stop_signal() {
+    return mSharedStop ? *mSharedStop : mStopSignal;
+  }
+
+  // True once stopped; a passed hard deadline raises the stop token so
+  // the rest of the search (and other engines sharing it) stop too.
+  bool out_of_time() {
+    if (stop_signal().raised()) {
+      return true;
+    }
+    if (timer.exceeded(MAX_SECONDS)) {
+      stop_signal().raise();
+      return true;
+    }
+    return false;
+  }
+
+  TranspositionTable<M, E>& tt() {
+    return shared_tt() ? *mSharedTTPtr : flat_tt;
+  }
+
+  // fill_legal_moves's max_moves at this node (see MinimaxWidthConfig).
+  int move_cap(int indent, int depth, bool pv_node) const {
+    return mWidth.enabled ? mWidth.cap(indent, depth, pv_node) : MAX_MOVES;
+  }
+
+  // The policy's answers; constants unless P leaves them to run time.
+  bool shared_tt() const {
+    if constexpr (P::tt_mode == MinimaxTTMode::Runtime) {
+      return mSharedTTPtr != nullptr;
+    } else {
+      return P::tt_mode == MinimaxTTMode::Shared;
+    }
+  }
+
+  bool local_tt() const {
+    return kOwnsTT && !shared_tt();
+  }
+
+  bool use_tt() const {
+    if constexpr (P::tt_mode == MinimaxTTMode::Runtime) {
+      return mUseTranspositionTable;
+    } else {
+      return P::tt_mode != MinimaxTTMode::None;
+    }
+  }
+
+  std::ostream* trace_stream() const {
+    if constexpr (P::trace) {
+      return mTraceStream;
+    } else {
+      return nullptr;
+    }
+  }
+
+  int evaluate(S *state) {
+    if constexpr (std::is_same<typename P::evaluator_type, RuntimeEvaluator>::value) {
+      return get_goodness ? get_goodness(state) : state->get_goodness();
+    } else {
+      return mEvaluator(*state);
+    }
+  }
+
+  // Look up a position in the bucketed transposition table.
   //
   // Example: state has hash=0xABCD1234, verification_key=0x9876...
-  //   slot index = 0xABCD1234 & 0x3FFFF = 0x1234  (lower 18 bits)
-  //   flat_tt[0x1234].verification_key == 0x9876... ?
+  //   bucket index = 0xABCD1234 & 0x7FFF = 0x1234  (lower 15 bits at 18 size bits)
+  //   any entry in bucket 0x1234 (7 packed or 4 wide) matching 0x9876... ?
   //     yes → entry found (same position, or astronomically unlikely collision)
-  //     no  → miss (slot empty or holds a different position)
-  bool get_tt_entry(S *state, TTEntry<M> &entry) {
-    auto key = state->hash();
-    TTEntry<M>* tt = mSharedTTPtr ? mSharedTTPtr : flat_tt.data();
-    auto& slot = tt[key & mTTMask];
-    if (!slot.matches(state->tt_verification_key())) {
-      return false;
-    }
-    entry = slot;
-    return true;
+  //     no  → miss (position not stored, or evicted)
+  bool get_tt_entry(S *state, E &entry) {
+    return tt().probe(state->hash(), state->tt_verification_key(), entry);
   }
 
-  // Store a position in the flat TT. "Always replace" policy: if the slot
-  // is occupied by a different position, it's silently overwritten.
-  void add_tt_entry(S *state, const TTEntry<M> &entry) {
-    auto key = state->hash();
-    TTEntry<M>* tt = mSharedTTPtr ? mSharedTTPtr : flat_tt.data();
-    tt[key & mTTMask] = entry;
+  // Store a position in its bucket; the table decides which slot to
+  // overwrite (depth, bound type and age — see TranspositionTable::store).
+  void add_tt_entry(S *state, const E &entry) {
+    tt().store(state->hash(), state->tt_verification_key(), entry);
   }
 
   void update_tt(S *state, int alpha, int beta, int max_goodness, M &best_move, int depth) {
@@ -996,7 +2983,7 @@ struct Minimax : public Algorithm<S, M> {
     else {
       value_type = TTEntryType::EXACT_VALUE;
     }
-    TTEntry<M> entry = {best_move, state->tt_verification_key(), depth, max_goodness, value_type};
+    E entry = {best_move, state->tt_verification_key(), depth, max_goodness, value_type};
     add_tt_entry(state, entry);
   }
 
@@ -1005,6 +2992,11 @@ struct Minimax : public Algorithm<S, M> {
   }
 };
 
+// The engine with every choice made at run time, as used by the parallel
+// searches, the server and the driver.
+template<class S, class M, class E = TTEntry<M>>
+using Minimax = MinimaxEngine<S, M, E, RuntimeMinimaxPolicy>;
+
 // https://en.wikipedia.org/wiki/Monte_Carlo_tree_search
 template<class S, class M>
 struct MonteCarloTreeSearch : public Algorithm<S, M> {
@@ -1012,6 +3004,7 @@ struct MonteCarloTreeSearch : public Algorithm<S, M> {
   const int max_simulations;
   const bool block;
   Random random;
+  StopSignal mStopSignal;
 
   MonteCarloTreeSearch(double max_seconds = 1,
                        int max_simulations = MAX_SIMULATIONS,
@@ -1030,7 +3023,7 @@ struct MonteCarloTreeSearch : public Algorithm<S, M> {
     Timer timer;
     timer.start();
     int simulation = 0;
-    while (simulation < max_simulations && !timer.exceeded(max_seconds)) {
+    while (simulation < max_simulations && !timer.exceeded(max_seconds) && !mStopSignal.raised()) {
       monte_carlo_tree_search(root);
       ++simulation;
     }
@@ -1048,9 +3041,18 @@ struct MonteCarloTreeSearch : public Algorithm<S, M> {
       }
       LOG(DEBUG) << std::endl;
     }
+    mStopSignal.clear();
     return get_most_visited_move(root);
   }
 
+  void stop() override {
+    mStopSignal.request();
+  }
+
+  void clear_stop() override {
+    mStopSignal.clear();
+  }
+
   void monte_carlo_tree_search(S *root) {
     S *current = tree_policy(root, root);
     auto result = rollout(current, root);
@@ -48,6 +48,16 @@ struct InlineBitset {
     return memcmp(words, rhs.words, nwords * 8) == 0;
   }
 
+  // Number of set bits in the used portion.
+  int count() const {
+    const int nwords = (size_bits + 63) >> 6;
+    int total = 0;
+    for (int w = 0; w < nwords; w++) {
+      total += __builtin_popcountll(words[w]);
+    }
+    return total;
+  }
+
   // OR all words from another InlineBitset into this one.
   // Both must have the same size. Used in fill_legal_moves to accumulate
   // per-cell word bitsets into a single "all reachable words" bitset.
@@ -0,0 +1,211 @@
+// opening-book.h — Precomputed opening moves for one board.
+//
+// wordbase-book-build searches the opening tree of a board offline, far
+// deeper than a live turn allows, and saves the best moves it finds per
+// position; wordbase-server answers any position found in a loaded book
+// without searching.
+//
+// Moves are stored as LegalWordIds, which depend on both the board and
+// the dictionary, so a book records the board text, the number of legal
+// words it was built with and a checksum of the legal-word list (each
+// id's word and cells), and matches() rejects any other pairing.
+//
+// File layout (native byte order, fixed-width fields):
+//   "WBBOOK02"        8-byte magic
+//   uint32            board text length
+//   board text        as given to the builder, bomb markers included
+//   uint32            legal word count
+//   uint64            legal-word list checksum (legalWordsChecksum)
+//   uint32            entry count
+//   entries           28 bytes each, sorted by (hash, key, rank)
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// One book move. A position has up to the builder's --width of these,
+// rank 0 being the best.
+struct OpeningBookEntry {
+  uint64_t hash;      // WordBaseState::hash()
+  uint64_t key;       // WordBaseState::tt_verification_key()
+  int32_t move;       // LegalWordId
+  int32_t score;      // from the side to move's view, searched to `depth`
+  uint16_t depth;
+  uint16_t rank;
+};
+
+class OpeningBook {
+  static constexpr char kMagic[8] = {'W', 'B', 'B', 'O', 'O', 'K', '0', '2'};
+  static constexpr size_t kEntryBytes = 28;
+
+  std::string mBoardText;
+  uint32_t mLegalWordCount = 0;
+  uint64_t mLegalWordsChecksum = 0;
+  std::vector<OpeningBookEntry> mEntries;
+
+  static bool entryLess(const OpeningBookEntry& a, const OpeningBookEntry& b) {
+    return std::tie(a.hash, a.key, a.rank) < std::tie(b.hash, b.key, b.rank);
+  }
+
+  template<class T>
+  static void write(std::ofstream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  template<class T>
+  static T read(std::ifstream& in) {
+    T value;
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+  }
+
+public:
+  OpeningBook() = default;
+
+  OpeningBook(const std::string& boardText, const BoardStatic& board)
+    : mBoardText(boardText),
+      mLegalWordCount(static_cast<uint32_t>(board.getLegalWordsSize())),
+      mLegalWordsChecksum(legalWordsChecksum(board)) {}
+
+  const std::string& boardText() const { return mBoardText; }
+  uint32_t legalWordCount() const { return mLegalWordCount; }
+  size_t size() const { return mEntries.size(); }
+
+  // FNV-1a over every legal word in id order: its letters, then its cells.
+  // Two dictionaries that give a board the same number of legal words
+  // almost never give it the same list.
+  static uint64_t legalWordsChecksum(const BoardStatic& board) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    auto mix = [&hash](uint64_t value) {
+      hash ^= value;
+      hash *= 0x100000001b3ULL;
+    };
+    for (int id = 0; id < board.getLegalWordsSize(); id++) {
+      const LegalWord& word = board.getLegalWord(id);
+      for (const char letter : word.mWord) mix(static_cast<unsigned char>(letter));
+      for (const auto& cell : word.mWordSequence) {
+        mix(0x100 + cell.first);
+        mix(0x100 + cell.second);
+      }
+      mix(0x200);  // word separator
+    }
+    return hash;
+  }
+
+  // True if this book's word ids mean the same words on `board`.
+  bool matches(const BoardStatic& board) const {
+    return mLegalWordCount == static_cast<uint32_t>(board.getLegalWordsSize())
+      && mLegalWordsChecksum == legalWordsChecksum(board);
+  }
+
+  void add(const WordBaseState& state, const WordBaseMove& move, int score, int depth, int rank) {
+    mEntries.push_back({state.hash(), state.tt_verification_key(),
+                        static_cast<int32_t>(move.mLegalWordId), static_cast<int32_t>(score),
+                        static_cast<uint16_t>(depth), static_cast<uint16_t>(rank)});
+  }
+
+  // The book moves for `state`, best first. Empty if the book does not
+  // cover it.
+  std::vector<OpeningBookEntry> lookup(const WordBaseState& state) const {
+    OpeningBookEntry probe{state.hash(), state.tt_verification_key(), 0, 0, 0, 0};
+    auto first = std::lower_bound(mEntries.begin(), mEntries.end(), probe, entryLess);
+    std::vector<OpeningBookEntry> result;
+    for (auto it = first; it != mEntries.end() && it->hash == probe.hash && it->key == probe.key; ++it) {
+      result.push_back(*it);
+    }
+    return result;
+  }
+
+  // The best book move that is legal in `state`. A move can only be
+  // illegal here on a full hash and key collision, but a book answer
+  // skips the search entirely, so it is checked anyway.
+  bool probe(const WordBaseState& state, OpeningBookEntry& best) const {
+    for (const auto& entry : lookup(state)) {
+      WordBaseMove move;
+      move.mLegalWordId = entry.move;
+      if (state.isValidMove(move)) {
+        best = entry;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void save(const std::string& path) {
+    std::sort(mEntries.begin(), mEntries.end(), entryLess);
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+      throw std::runtime_error("Could not write opening book: " + path);
+    }
+    out.write(kMagic, sizeof(kMagic));
+    write<uint32_t>(out, static_cast<uint32_t>(mBoardText.size()));
+    out.write(mBoardText.data(), mBoardText.size());
+    write<uint32_t>(out, mLegalWordCount);
+    write<uint64_t>(out, mLegalWordsChecksum);
+    write<uint32_t>(out, static_cast<uint32_t>(mEntries.size()));
+    for (const auto& entry : mEntries) {
+      write(out, entry.hash);
+      write(out, entry.key);
+      write(out, entry.move);
+      write(out, entry.score);
+      write(out, entry.depth);
+      write(out, entry.rank);
+    }
+    if (!out) {
+      throw std::runtime_error("Could not write opening book: " + path);
+    }
+  }
+
+  static OpeningBook load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+      throw std::runtime_error("Could not open opening book: " + path);
+    }
+    char magic[sizeof(kMagic)];
+    in.read(magic, sizeof(magic));
+    if (!in || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+      throw std::runtime_error("Not an opening book: " + path);
+    }
+    OpeningBook book;
+    const uint32_t boardSize = read<uint32_t>(in);
+    if (!in || boardSize > 4 * kBoardHeight * kBoardWidth) {
+      throw std::runtime_error("Not an opening book: " + path);
+    }
+    book.mBoardText.resize(boardSize);
+    in.read(&book.mBoardText[0], boardSize);
+    book.mLegalWordCount = read<uint32_t>(in);
+    book.mLegalWordsChecksum = read<uint64_t>(in);
+    const uint32_t count = read<uint32_t>(in);
+    // The count comes from the file: check it against what is left before
+    // reserving, so a corrupt header cannot ask for gigabytes.
+    const std::streampos entriesStart = in.tellg();
+    in.seekg(0, std::ios::end);
+    const std::streamoff remaining = in.tellg() - entriesStart;
+    in.seekg(entriesStart);
+    if (!in || remaining < 0 || static_cast<uint64_t>(remaining) < uint64_t{count} * kEntryBytes) {
+      throw std::runtime_error("Truncated opening book: " + path);
+    }
+    book.mEntries.reserve(count);
+    for (uint32_t i = 0; i < count && in; i++) {
+      OpeningBookEntry entry;
+      entry.hash = read<uint64_t>(in);
+      entry.key = read<uint64_t>(in);
+      entry.move = read<int32_t>(in);
+      entry.score = read<int32_t>(in);
+      entry.depth = read<uint16_t>(in);
+      entry.rank = read<uint16_t>(in);
+      book.mEntries.push_back(entry);
+    }
+    if (!in) {
+      throw std::runtime_error("Truncated opening book: " + path);
+    }
+    std::sort(book.mEntries.begin(), book.mEntries.end(), entryLess);
+    return book;
+  }
+};
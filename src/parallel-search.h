@@ -1,70 +1,354 @@
-// parallel-search.h — Three parallel search strategies for comparison.
+// parallel-search.h — Four parallel search strategies for comparison.
 //
-// All three implement Algorithm<S,M> and expose getLastSearchStats().
-// Use --parallel-mode root|lazysmp|ybwc --threads N in perf-test.
+// All four implement Algorithm<S,M> and expose getLastSearchStats().
+// Use --parallel-mode root|lazysmp|ybwc|abdada --threads N in perf-test.
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <utility>
 #include <vector>
 
+// Persistent search threads for the parallel strategies. Worker t runs
+// every task posted to slot t, so a strategy's slot-t engine is only ever
+// touched by one long-lived thread, and a search costs two atomic
+// handoffs per thread instead of a thread start and join.
+//
+// A task is handed over through the worker's mailbox, a single-slot
+// queue: the caller stores the task and bumps the worker's posted count,
+// and the worker runs it once it sees the count move. Both sides spin
+// briefly (yielding) before parking on a condition variable, and only
+// touch its mutex when the other side is parked, so back-to-back
+// searches never block.
+class SearchThreadPool {
+  static constexpr int SPIN_ROUNDS = 1024;
+
+  struct Worker {
+    std::thread thread;
+    std::function<void()> task;  // empty: exit
+    std::atomic<uint64_t> posted{0};
+    std::atomic<bool> parked{false};
+    std::mutex mutex;
+    std::condition_variable wake;
+  };
+
+  std::vector<std::unique_ptr<Worker>> mWorkers;
+  std::atomic<int> mPending{0};
+  std::atomic<bool> mWaiting{false};
+  std::mutex mDoneMutex;
+  std::condition_variable mDone;
+
+public:
+  SearchThreadPool() = default;
+  SearchThreadPool(const SearchThreadPool&) = delete;
+  SearchThreadPool& operator=(const SearchThreadPool&) = delete;
+  ~SearchThreadPool() {
+    for (auto& worker : mWorkers) {
+      worker->task = nullptr;
+      signal(*worker);
+    }
+    for (auto& worker : mWorkers) {
+      worker->thread.join();
+    }
+  }
+
+  int size() const { return static_cast<int>(mWorkers.size()); }
+
+  // Start workers until there are at least count. Workers are never
+  // stopped before the pool is destroyed.
+  void reserve(int count) {
+    while (size() < count) {
+      mWorkers.push_back(std::make_unique<Worker>());
+      Worker* worker = mWorkers.back().get();
+      worker->thread = std::thread([this, worker]() { run(*worker); });
+    }
+  }
+
+  // Run task on worker slot, which must be idle (no task since the last
+  // wait()). Returns at once.
+  void post(int slot, std::function<void()> task) {
+    Worker& worker = *mWorkers[slot];
+    worker.task = std::move(task);
+    mPending.fetch_add(1, std::memory_order_relaxed);
+    signal(worker);
+  }
+
+  // Block until every posted task has returned.
+  void wait() {
+    for (int spin = 0; mPending.load(std::memory_order_acquire) != 0; spin++) {
+      if (spin < SPIN_ROUNDS) {
+        std::this_thread::yield();
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mDoneMutex);
+      mWaiting.store(true);
+      mDone.wait(lock, [this]() { return mPending.load() == 0; });
+      mWaiting.store(false);
+    }
+  }
+
+private:
+  // Publish worker.task. The seq_cst store/load pair against run()'s
+  // parked store/posted load means either the worker sees the new count
+  // before parking, or this sees it parked and wakes it.
+  void signal(Worker& worker) {
+    worker.posted.fetch_add(1);
+    if (worker.parked.load()) {
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      worker.wake.notify_one();
+    }
+  }
+
+  void run(Worker& worker) {
+    uint64_t seen = 0;
+    for (;;) {
+      for (int spin = 0; worker.posted.load(std::memory_order_acquire) == seen; spin++) {
+        if (spin < SPIN_ROUNDS) {
+          std::this_thread::yield();
+          continue;
+        }
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        worker.parked.store(true);
+        worker.wake.wait(lock, [&]() { return worker.posted.load() != seen; });
+        worker.parked.store(false);
+      }
+      ++seen;
+      if (!worker.task) {
+        return;
+      }
+      worker.task();
+      worker.task = nullptr;
+      if (mPending.fetch_sub(1) == 1 && mWaiting.load()) {
+        std::lock_guard<std::mutex> lock(mDoneMutex);
+        mDone.notify_all();
+      }
+    }
+  }
+};
+
 // Common base for all parallel strategies. Holds shared config and helpers.
-template<class S, class M>
+// E selects the TT entry layout, as for Minimax.
+template<class S, class M, class E = TTEntry<M>>
 struct ParallelSearchBase : public Algorithm<S, M> {
   int mNumThreads;
   double mMaxSeconds;
+  double mSoftSeconds = 0.0;
   int mMaxMoves;
   int mMaxDepth;
   bool mUseTranspositionTable;
   size_t mTTSizeBits;
+  bool mTTHugePages = true;
   std::function<int(S*)> mGetGoodness;
-  typename Minimax<S, M>::SearchStats mLastSearchStats;
+  typename Minimax<S, M, E>::AspirationConfig mAspiration;
+  typename Minimax<S, M, E>::SelectiveConfig mSelective;
+  typename Minimax<S, M, E>::QuiescenceConfig mQuiescence;
+  typename Minimax<S, M, E>::SolverConfig mSolver;
+  typename Minimax<S, M, E>::WidthConfig mWidth;
+  typename Minimax<S, M, E>::TimeConfig mTimeConfig;
+  typename Minimax<S, M, E>::SearchStats mLastSearchStats;
+  int mMultiPV = 1;
+  bool mTrackPV = true;
+  bool mDiversifyHelpers = true;
+  std::vector<typename Minimax<S, M, E>::RootLine> mLastRootLines;
 
   ParallelSearchBase(int numThreads, double maxSeconds, int maxMoves = INF,
                      int maxDepth = MAX_DEPTH, bool useTT = true,
-                     size_t ttSizeBits = Minimax<S, M>::DEFAULT_TT_SIZE_BITS,
+                     size_t ttSizeBits = Minimax<S, M, E>::DEFAULT_TT_SIZE_BITS,
                      std::function<int(S*)> getGoodness = nullptr)
     : mNumThreads(numThreads), mMaxSeconds(maxSeconds), mMaxMoves(maxMoves),
       mMaxDepth(maxDepth), mUseTranspositionTable(useTT), mTTSizeBits(ttSizeBits),
       mGetGoodness(getGoodness) {}
 
-  const typename Minimax<S, M>::SearchStats& getLastSearchStats() const {
+  const typename Minimax<S, M, E>::SearchStats& getLastSearchStats() const {
     return mLastSearchStats;
   }
 
+  // Multi-PV lines of the last search: the chosen Lazy SMP thread's, or
+  // the YBWC main thread's. Empty for root splitting (see setMultiPV).
+  const std::vector<typename Minimax<S, M, E>::RootLine>& getRootLines() const {
+    return mLastRootLines;
+  }
+
+  // Applied to every per-thread engine. Each thread keeps its own window
+  // centered on its own previous iteration's score.
+  void setAspirationConfig(const typename Minimax<S, M, E>::AspirationConfig& aspiration) {
+    mAspiration = aspiration;
+  }
+
+  // Null-move / ProbCut switches and margins for every per-thread engine.
+  void setSelectiveConfig(const typename Minimax<S, M, E>::SelectiveConfig& selective) {
+    mSelective = selective;
+  }
+
+  // Horizon capture search for every per-thread engine.
+  void setQuiescenceConfig(const typename Minimax<S, M, E>::QuiescenceConfig& quiescence) {
+    mQuiescence = quiescence;
+  }
+
+  // Per-node move caps for every per-thread engine. The root cap also
+  // bounds the moves that root splitting and YBWC hand out.
+  void setWidthConfig(const typename Minimax<S, M, E>::WidthConfig& width) {
+    mWidth = width;
+  }
+
+  // Endgame solver, run by the engine in slot 0 only: the other slots would
+  // prove the same position again.
+  void setSolverConfig(const typename Minimax<S, M, E>::SolverConfig& solver) {
+    mSolver = solver;
+  }
+
+  // Huge-page backing for the shared and per-thread tables (default on).
+  void setTTHugePages(bool hugePages) {
+    mTTHugePages = hugePages;
+  }
+
+  void setMaxSeconds(double seconds) { mMaxSeconds = seconds; }
+  // Soft deadline and deepening policy for every thread (see MinimaxTimeConfig).
+  void setSoftSeconds(double seconds) { mSoftSeconds = seconds; }
+  void setTimeConfig(const typename Minimax<S, M, E>::TimeConfig& time) { mTimeConfig = time; }
+  // Stops every thread: they all poll one shared token (see
+  // Minimax::setSharedStop).
+  void stop() override { mStopSignal.request(); }
+  void clear_stop() override { mStopSignal.clear(); }
+  void setMaxDepth(int depth) { mMaxDepth = depth; }
+  // Multi-PV for engines that search every root move (Lazy SMP threads,
+  // the YBWC main thread). Engines restricted to a subset of root moves
+  // (root splitting, YBWC workers) keep searching a single line.
+  void setMultiPV(int lines) { mMultiPV = std::max(1, lines); }
+  // SearchStats::pv of every engine (see Minimax::setTrackPV). The merged
+  // stats carry the line of the thread whose move is played.
+  void setTrackPV(bool track) { mTrackPV = track; }
+  // Lazy SMP helper threads skip depths, perturb their history and shift
+  // their LMR (see Minimax::setHelperIndex). On by default; the other
+  // strategies split root moves instead and never diversify.
+  void setDiversifyHelpers(bool diversify) { mDiversifyHelpers = diversify; }
+
+  // Forget everything learned so far (new game): drops the per-thread
+  // engines and their history, and wipes the shared TT.
+  void reset() override {
+    mEngines.clear();
+    if (!mSharedTT.empty()) mSharedTT.clear();
+  }
+
 protected:
+  // Per-thread engines, their threads (mPool) and the shared TT persist
+  // across get_move calls.
+  // Each engine keeps 1/8 of its history and continuation-history scores
+  // at the start of a search instead of starting from zero (see
+  // Minimax::get_move); its countermoves carry over unaged, overwritten as
+  // new cutoffs find better replies. Shared-TT entries from
+  // earlier turns stay probe-able, aging out through the generation stamp
+  // (see TranspositionTable). The positions a game reaches on consecutive
+  // turns overlap heavily, so the first iterations of the next search
+  // mostly hit warm entries.
+  std::vector<std::unique_ptr<Minimax<S, M, E>>> mEngines;
+  TranspositionTable<M, E> mSharedTT;
+  // Shared by every engine. Raised by stop(), by the first engine past the
+  // hard deadline, or by the strategy once its main thread is done; cleared
+  // by endSearch().
+  StopSignal mStopSignal;
+  // Set by strategies whose engines share the moves they are searching
+  // (ABDADA); nullptr for the rest.
+  std::unique_ptr<BusyMoveTable> mBusyMoves;
+  // Runs slot t's searches on worker t. Declared last, so its threads are
+  // joined before the engines and table they use are destroyed.
+  SearchThreadPool mPool;
+
   struct ThreadResult {
     M bestMove{};
-    typename Minimax<S, M>::SearchStats stats{};
+    typename Minimax<S, M, E>::SearchStats stats{};
+    std::vector<typename Minimax<S, M, E>::RootLine> lines;
   };
 
   // Configure a Minimax engine with this strategy's settings.
-  void configureEngine(Minimax<S, M>& engine, TTEntry<M>* sharedTT = nullptr,
+  void configureEngine(Minimax<S, M, E>& engine, TranspositionTable<M, E>* sharedTT = nullptr,
                        const std::vector<M>* rootMoves = nullptr) {
+    engine.setMaxSeconds(mMaxSeconds);
+    engine.setSoftSeconds(mSoftSeconds);
+    engine.setTimeConfig(mTimeConfig);
     engine.setMaxDepth(mMaxDepth);
     engine.setUseTranspositionTable(mUseTranspositionTable);
+    engine.setTTHugePages(mTTHugePages);
     engine.setTTSizeBits(mTTSizeBits);
     engine.setTraceStream(nullptr);
+    engine.setSharedStop(&mStopSignal);
+    engine.setBusyMoveTable(mBusyMoves.get());
+    engine.setAspirationConfig(mAspiration);
+    engine.setSelectiveConfig(mSelective);
+    engine.setQuiescenceConfig(mQuiescence);
+    engine.setWidthConfig(mWidth);
+    engine.setSolverConfig(mSolver);
+    engine.setMultiPV(rootMoves ? 1 : mMultiPV);
+    engine.setTrackPV(mTrackPV);
     if (sharedTT) engine.setSharedTT(sharedTT);
     if (rootMoves) engine.setRootMoves(*rootMoves);
+    else engine.clearRootMoves();
+  }
+
+  // Create engines for slots [0, count). Call before starting threads.
+  void ensureEngines(int count) {
+    if (static_cast<int>(mEngines.size()) < count) mEngines.resize(count);
+    for (int t = 0; t < count; t++) {
+      if (!mEngines[t]) {
+        mEngines[t] = std::make_unique<Minimax<S, M, E>>(mMaxSeconds, mMaxMoves, mGetGoodness);
+      }
+    }
+  }
+
+  // The root's move cap: what the engines would generate there.
+  int rootMoveCap() const {
+    return mWidth.enabled ? mWidth.root_moves : mMaxMoves;
+  }
+
+  // Call in get_move once every thread is done. Clears the stop token
+  // here rather than at the start, so a stop() sent before the search
+  // began still ends it.
+  void endSearch() {
+    mStopSignal.clear();
   }
 
-  // Run a search on a thread: clone state, create engine, search, store result.
-  void runThread(S* state, ThreadResult& result,
-                 TTEntry<M>* sharedTT = nullptr,
-                 const std::vector<M>* rootMoves = nullptr) {
+  // Size the shared table (first use or size change) and open a new
+  // generation instead of wiping it. Called once by the strategy before
+  // any thread starts.
+  void prepareSharedTT() {
+    if (mSharedTT.size_bits() != mTTSizeBits) mSharedTT.resize(mTTSizeBits, mTTHugePages);
+    mSharedTT.new_search();
+  }
+
+  // Run a search on a thread: clone state, search with the slot's engine,
+  // store result.
+  // helper is the engine's Minimax::setHelperIndex.
+  void runThread(int slot, S* state, ThreadResult& result,
+                 TranspositionTable<M, E>* sharedTT = nullptr,
+                 const std::vector<M>* rootMoves = nullptr, int helper = 0) {
     S threadState = state->clone();
-    Minimax<S, M> engine(mMaxSeconds, mMaxMoves, mGetGoodness);
+    Minimax<S, M, E>& engine = *mEngines[slot];
     configureEngine(engine, sharedTT, rootMoves);
+    engine.setHelperIndex(helper);
+    if (slot != 0) {
+      typename Minimax<S, M, E>::SolverConfig off = mSolver;
+      off.enabled = false;
+      engine.setSolverConfig(off);
+    }
     result.bestMove = engine.get_move(&threadState);
     result.stats = engine.getLastSearchStats();
+    result.lines = engine.getRootLines();
   }
 
-  // Pick the best result: prefer deeper search, break ties by score.
+  // Pick the best result: a proof beats any search, then prefer deeper
+  // search, break ties by score.
   static int pickBest(const std::vector<ThreadResult>& results, int count) {
     int bestIdx = 0;
     for (int t = 1; t < count; t++) {
-      if (results[t].stats.max_depth > results[bestIdx].stats.max_depth ||
+      if (results[bestIdx].stats.stop_reason == SearchStopReason::Proven) break;
+      if (results[t].stats.stop_reason == SearchStopReason::Proven ||
+          results[t].stats.max_depth > results[bestIdx].stats.max_depth ||
           (results[t].stats.max_depth == results[bestIdx].stats.max_depth &&
            results[t].stats.goodness > results[bestIdx].stats.goodness)) {
         bestIdx = t;
@@ -73,6 +357,54 @@ protected:
     return bestIdx;
   }
 
+  // Lazy SMP's choice: a proof beats any search; else a forced win, the
+  // shortest; else the move with the most votes, where each thread that
+  // completed a depth votes for its move with weight
+  // (score - worst score + VOTE_SCORE_OFFSET) * depth, so a move found
+  // deep and scored high by several threads wins over one thread's
+  // outlier. Among the threads behind the winning move, the deepest (then
+  // highest scoring) one's result is used.
+  static int pickVoted(const std::vector<ThreadResult>& results, int count) {
+    static constexpr long long VOTE_SCORE_OFFSET = 20;
+    int bestIdx = -1;
+    int minScore = INF;
+    for (int t = 0; t < count; t++) {
+      const auto& stats = results[t].stats;
+      if (stats.stop_reason == SearchStopReason::Proven) return t;
+      if (stats.max_depth == 0) continue;
+      minScore = std::min(minScore, stats.goodness);
+      if (stats.goodness >= INF - 1000
+          && (bestIdx < 0 || stats.goodness > results[bestIdx].stats.goodness)) {
+        bestIdx = t;
+      }
+    }
+    if (bestIdx >= 0) return bestIdx;
+
+    std::vector<long long> votes(count, 0);
+    for (int t = 0; t < count; t++) {
+      const auto& stats = results[t].stats;
+      if (stats.max_depth == 0) continue;
+      const long long weight = (static_cast<long long>(stats.goodness) - minScore + VOTE_SCORE_OFFSET)
+        * stats.max_depth;
+      for (int u = 0; u < count; u++) {
+        if (results[u].stats.max_depth > 0 && results[u].bestMove == results[t].bestMove) {
+          votes[u] += weight;
+        }
+      }
+    }
+    for (int t = 0; t < count; t++) {
+      if (results[t].stats.max_depth == 0) continue;
+      if (bestIdx < 0 || votes[t] > votes[bestIdx]
+          || (votes[t] == votes[bestIdx]
+              && (results[t].stats.max_depth > results[bestIdx].stats.max_depth
+                  || (results[t].stats.max_depth == results[bestIdx].stats.max_depth
+                      && results[t].stats.goodness > results[bestIdx].stats.goodness)))) {
+        bestIdx = t;
+      }
+    }
+    return bestIdx < 0 ? 0 : bestIdx;
+  }
+
   // Aggregate stats from multiple results into mLastSearchStats.
   void aggregateStats(const ThreadResult& primary,
                       const std::vector<ThreadResult>& others, int count) {
@@ -83,6 +415,13 @@ protected:
       mLastSearchStats.leafs += others[t].stats.leafs;
       mLastSearchStats.beta_cuts += others[t].stats.beta_cuts;
       mLastSearchStats.tt_hits += others[t].stats.tt_hits;
+      mLastSearchStats.aspiration_fail_highs += others[t].stats.aspiration_fail_highs;
+      mLastSearchStats.aspiration_fail_lows += others[t].stats.aspiration_fail_lows;
+      mLastSearchStats.null_move_cuts += others[t].stats.null_move_cuts;
+      mLastSearchStats.probcut_cuts += others[t].stats.probcut_cuts;
+      mLastSearchStats.win_in_one_cuts += others[t].stats.win_in_one_cuts;
+      mLastSearchStats.quiescence_nodes += others[t].stats.quiescence_nodes;
+      mLastSearchStats.proof_nodes += others[t].stats.proof_nodes;
       maxElapsed = std::max(maxElapsed, others[t].stats.elapsed_seconds);
     }
     mLastSearchStats.elapsed_seconds = maxElapsed;
@@ -97,12 +436,26 @@ protected:
     mLastSearchStats.leafs = 0;
     mLastSearchStats.beta_cuts = 0;
     mLastSearchStats.tt_hits = 0;
+    mLastSearchStats.aspiration_fail_highs = 0;
+    mLastSearchStats.aspiration_fail_lows = 0;
+    mLastSearchStats.null_move_cuts = 0;
+    mLastSearchStats.probcut_cuts = 0;
+    mLastSearchStats.win_in_one_cuts = 0;
+    mLastSearchStats.quiescence_nodes = 0;
+    mLastSearchStats.proof_nodes = 0;
     double maxElapsed = 0;
     for (int t = 0; t < count; t++) {
       mLastSearchStats.nodes += results[t].stats.nodes;
       mLastSearchStats.leafs += results[t].stats.leafs;
       mLastSearchStats.beta_cuts += results[t].stats.beta_cuts;
       mLastSearchStats.tt_hits += results[t].stats.tt_hits;
+      mLastSearchStats.aspiration_fail_highs += results[t].stats.aspiration_fail_highs;
+      mLastSearchStats.aspiration_fail_lows += results[t].stats.aspiration_fail_lows;
+      mLastSearchStats.null_move_cuts += results[t].stats.null_move_cuts;
+      mLastSearchStats.probcut_cuts += results[t].stats.probcut_cuts;
+      mLastSearchStats.win_in_one_cuts += results[t].stats.win_in_one_cuts;
+      mLastSearchStats.quiescence_nodes += results[t].stats.quiescence_nodes;
+      mLastSearchStats.proof_nodes += results[t].stats.proof_nodes;
       maxElapsed = std::max(maxElapsed, results[t].stats.elapsed_seconds);
     }
     mLastSearchStats.elapsed_seconds = maxElapsed;
@@ -131,29 +484,31 @@ protected:
 //   - No information sharing between threads (separate TTs)
 //   - Weaker alpha bounds (each thread only knows its own best)
 // ---------------------------------------------------------------------------
-template<class S, class M>
-struct RootParallelSearch : public ParallelSearchBase<S, M> {
-  using Base = ParallelSearchBase<S, M>;
+template<class S, class M, class E = TTEntry<M>>
+struct RootParallelSearch : public ParallelSearchBase<S, M, E> {
+  using Base = ParallelSearchBase<S, M, E>;
   using typename Base::ThreadResult;
 
   using Base::Base;  // inherit constructor
 
   M get_move(S* state) override {
     std::vector<M> allMoves;
-    state->fill_legal_moves(allMoves, this->mMaxMoves);
+    state->fill_legal_moves(allMoves, this->rootMoveCap());
     if (allMoves.empty()) return M();
 
     auto threadMoves = Base::distributeMoves(allMoves, this->mNumThreads);
     std::vector<ThreadResult> results(this->mNumThreads);
 
-    std::vector<std::thread> threads;
+    this->ensureEngines(this->mNumThreads);
+    this->mPool.reserve(this->mNumThreads);
     for (int t = 0; t < this->mNumThreads; t++) {
       if (threadMoves[t].empty()) continue;
-      threads.emplace_back([&, t]() {
-        this->runThread(state, results[t], nullptr, &threadMoves[t]);
+      this->mPool.post(t, [&, t]() {
+        this->runThread(t, state, results[t], nullptr, &threadMoves[t]);
       });
     }
-    for (auto& t : threads) t.join();
+    this->mPool.wait();
+    Base::endSearch();
 
     int bestIdx = Base::pickBest(results, this->mNumThreads);
     Base::aggregateStats(results, this->mNumThreads, bestIdx);
@@ -167,43 +522,56 @@ struct RootParallelSearch : public ParallelSearchBase<S, M> {
 // Strategy 2: Lazy SMP (Symmetric Multi-Processing)
 //
 // All N threads run full iterative deepening from the root, sharing a single
-// transposition table. Standard approach used by Stockfish.
+// transposition table. Standard approach used by Stockfish. As there,
+// helper threads are diversified so they do not repeat the main thread's
+// tree: each skips some depths on a staggered schedule, starts from
+// perturbed history, and reduces late moves more or less aggressively
+// (Minimax::setHelperIndex). The result is chosen by depth- and
+// score-weighted voting (pickVoted).
 //
 //   + Shared TT provides automatic information sharing
 //   + All threads explore the full move space
-//   - Benign data races on TT (caught by verification key)
+//   - Benign data races on TT (torn or stale entries fail the key check;
+//     see TTBucket)
 //   - Some redundant work across threads
 // ---------------------------------------------------------------------------
-template<class S, class M>
-struct LazySMPSearch : public ParallelSearchBase<S, M> {
-  using Base = ParallelSearchBase<S, M>;
+template<class S, class M, class E = TTEntry<M>>
+struct LazySMPSearch : public ParallelSearchBase<S, M, E> {
+  using Base = ParallelSearchBase<S, M, E>;
   using typename Base::ThreadResult;
 
   using Base::Base;
 
   M get_move(S* state) override {
-    size_t ttSize = 1ULL << this->mTTSizeBits;
-    if (mSharedTT.size() != ttSize) mSharedTT.assign(ttSize, TTEntry<M>{});
-    else std::fill(mSharedTT.begin(), mSharedTT.end(), TTEntry<M>{});
+    Base::prepareSharedTT();
 
     std::vector<ThreadResult> results(this->mNumThreads);
-    std::vector<std::thread> threads;
+    this->ensureEngines(this->mNumThreads);
+    this->mPool.reserve(this->mNumThreads);
     for (int t = 0; t < this->mNumThreads; t++) {
-      threads.emplace_back([&, t]() {
-        this->runThread(state, results[t], mSharedTT.data());
+      this->mPool.post(t, [&, t]() {
+        this->runThread(t, state, results[t], &this->mSharedTT, nullptr,
+                        this->mDiversifyHelpers ? t : 0);
+        // Thread 0 owns the time decision; helpers stop when it is done.
+        if (t == 0) this->mStopSignal.raise();
       });
     }
-    for (auto& t : threads) t.join();
+    this->mPool.wait();
+    Base::endSearch();
 
-    int bestIdx = Base::pickBest(results, this->mNumThreads);
+    int bestIdx = this->mDiversifyHelpers ? Base::pickVoted(results, this->mNumThreads)
+      : Base::pickBest(results, this->mNumThreads);
     Base::aggregateStats(results, this->mNumThreads, bestIdx);
+    // A voted helper was stopped by thread 0, which made the time decision.
+    if (this->mLastSearchStats.stop_reason != SearchStopReason::Proven) {
+      this->mLastSearchStats.stop_reason = results[0].stats.stop_reason;
+    }
+    this->mLastRootLines = results[bestIdx].lines;
     return results[bestIdx].bestMove;
   }
 
   std::string get_name() const override { return "LazySMP"; }
 
-private:
-  std::vector<TTEntry<M>> mSharedTT;
 };
 
 // ---------------------------------------------------------------------------
@@ -211,26 +579,26 @@ private:
 //
 // Main thread searches ALL root moves. Worker threads search only non-PV
 // moves, sharing the TT. Workers pre-populate TT entries for the main thread.
+// There are no split points below the root, so this is Lazy SMP with
+// restricted root moves; ABDADASearch splits interior nodes.
 //
 //   + PV move gets full attention; workers pre-compute non-PV subtrees
 //   - Workers may do redundant work
 //   - Main thread has more work than any single worker
 // ---------------------------------------------------------------------------
-template<class S, class M>
-struct YBWCSearch : public ParallelSearchBase<S, M> {
-  using Base = ParallelSearchBase<S, M>;
+template<class S, class M, class E = TTEntry<M>>
+struct YBWCSearch : public ParallelSearchBase<S, M, E> {
+  using Base = ParallelSearchBase<S, M, E>;
   using typename Base::ThreadResult;
 
   using Base::Base;
 
   M get_move(S* state) override {
     std::vector<M> allMoves;
-    state->fill_legal_moves(allMoves, this->mMaxMoves);
+    state->fill_legal_moves(allMoves, this->rootMoveCap());
     if (allMoves.empty()) return M();
 
-    size_t ttSize = 1ULL << this->mTTSizeBits;
-    if (mSharedTT.size() != ttSize) mSharedTT.assign(ttSize, TTEntry<M>{});
-    else std::fill(mSharedTT.begin(), mSharedTT.end(), TTEntry<M>{});
+    Base::prepareSharedTT();
 
     // Non-PV moves for workers (skip move[0], the expected best).
     std::vector<M> nonPvMoves(allMoves.begin() + 1, allMoves.end());
@@ -239,28 +607,33 @@ struct YBWCSearch : public ParallelSearchBase<S, M> {
 
     ThreadResult mainResult;
     std::vector<ThreadResult> workerResults(numWorkers);
-
-    std::vector<std::thread> threads;
+    this->ensureEngines(numWorkers + 1);
+    this->mPool.reserve(numWorkers + 1);
 
     // Main thread: all moves, shared TT.
-    threads.emplace_back([&]() {
-      this->runThread(state, mainResult, mSharedTT.data());
+    // Workers only pre-fill the TT for it, so they stop when it is done.
+    this->mPool.post(0, [&]() {
+      this->runThread(0, state, mainResult, &this->mSharedTT);
+      this->mStopSignal.raise();
     });
 
     // Workers: non-PV subsets, shared TT.
     for (int t = 0; t < numWorkers; t++) {
       if (workerMoves[t].empty()) continue;
-      threads.emplace_back([&, t]() {
-        this->runThread(state, workerResults[t], mSharedTT.data(), &workerMoves[t]);
+      this->mPool.post(t + 1, [&, t]() {
+        this->runThread(t + 1, state, workerResults[t], &this->mSharedTT, &workerMoves[t]);
       });
     }
-    for (auto& t : threads) t.join();
+    this->mPool.wait();
+    Base::endSearch();
 
-    // Check if any worker beat the main thread.
+    // Check if any worker beat the main thread (unless it proved the game).
     int bestDepth = mainResult.stats.max_depth;
     int bestScore = mainResult.stats.goodness;
     M bestMove = mainResult.bestMove;
-    for (int t = 0; t < numWorkers; t++) {
+    const std::vector<M>* bestPv = &mainResult.stats.pv;
+    const bool mainProven = mainResult.stats.stop_reason == SearchStopReason::Proven;
+    for (int t = 0; t < numWorkers && !mainProven; t++) {
       if (workerMoves[t].empty()) continue;
       if (workerResults[t].stats.max_depth > bestDepth ||
           (workerResults[t].stats.max_depth == bestDepth &&
@@ -268,18 +641,47 @@ struct YBWCSearch : public ParallelSearchBase<S, M> {
         bestMove = workerResults[t].bestMove;
         bestDepth = workerResults[t].stats.max_depth;
         bestScore = workerResults[t].stats.goodness;
+        bestPv = &workerResults[t].stats.pv;
       }
     }
 
     Base::aggregateStats(mainResult, workerResults, numWorkers);
+    this->mLastRootLines = mainResult.lines;
     this->mLastSearchStats.best_move = bestMove;
     this->mLastSearchStats.goodness = bestScore;
     this->mLastSearchStats.max_depth = bestDepth;
+    this->mLastSearchStats.pv = *bestPv;
     return bestMove;
   }
 
   std::string get_name() const override { return "YBWC"; }
 
-private:
-  std::vector<TTEntry<M>> mSharedTT;
+};
+
+// ---------------------------------------------------------------------------
+// Strategy 4: ABDADA — Interior-Node Splitting
+//
+// Lazy SMP threads that share a BusyMoveTable as well as the TT. At every
+// node at least Minimax::ABDADA_MIN_DEPTH deep, each thread searches the
+// first move, then skips the moves another thread is already searching
+// and returns to them once the rest are done, by when the TT usually holds
+// their results. Threads thereby spread over the moves of every interior
+// node, not just the root, without split-point bookkeeping: PVS, LMR and
+// staged move generation run unchanged in every thread. This is the
+// simplified ABDADA: busy flags live in a side table, not in TT entries.
+//
+//   + Interior-node parallelism with no locks or thread coordination
+//   + Falls back to Lazy SMP wherever the busy table says nothing
+//   - A deferred move is still searched, usually as a cheap TT hit
+// ---------------------------------------------------------------------------
+template<class S, class M, class E = TTEntry<M>>
+struct ABDADASearch : public LazySMPSearch<S, M, E> {
+  using Base = LazySMPSearch<S, M, E>;
+
+  template<class... Args>
+  explicit ABDADASearch(Args&&... args) : Base(std::forward<Args>(args)...) {
+    this->mBusyMoves = std::make_unique<BusyMoveTable>();
+  }
+
+  std::string get_name() const override { return "ABDADA"; }
 };
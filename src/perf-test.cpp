@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <random>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -23,6 +24,7 @@ struct PerfOptions {
   std::string dictionaryPath = kDefaultDictionaryPath;
   std::string boardText = kDefaultBoardText;
   double maxSecondsPerMove = 0.25;
+  double softSecondsPerMove = 0.0;  // 0: same as maxSecondsPerMove
   int maxMovesPerPosition = 200;
   int maxDepth = 4;
   int maxTurns = 200;
@@ -33,8 +35,26 @@ struct PerfOptions {
   bool useTranspositionTable = true;
   bool printBoards = false;
   int threads = 1;
-  std::string parallelMode;  // "", "root", "lazysmp", "ybwc"
+  std::string parallelMode;  // "", "root", "lazysmp", "ybwc", "abdada"
+  bool diversifyHelpers = true;  // lazysmp/abdada helper threads search differently
   int ttBits = 18;  // TT size = 2^ttBits entries
+  int ttMB = 0;  // when > 0, overrides ttBits with the largest table that fits
+  bool ttHugePages = true;
+  int ttProbeBench = 0;  // when > 0, only run the TT probe-latency benchmark
+  std::string ttEntry = "packed";  // "packed" (8-byte TTEntry) or "wide" (16-byte WideTTEntry)
+  std::string engine = "runtime";  // "runtime" (Minimax) or "static" (MinimaxEngine with a fixed policy)
+  Minimax<WordBaseState, WordBaseMove>::AspirationConfig aspiration;
+  Minimax<WordBaseState, WordBaseMove>::SelectiveConfig selective;
+  Minimax<WordBaseState, WordBaseMove>::QuiescenceConfig quiescence;
+  Minimax<WordBaseState, WordBaseMove>::SolverConfig solver;
+  bool solveBench = false;  // only time the endgame solver on race positions
+  Minimax<WordBaseState, WordBaseMove>::WidthConfig width;
+  Minimax<WordBaseState, WordBaseMove>::TimeConfig time;
+  int multiPV = 1;  // > 1: search this many root lines with exact scores
+  bool trackPV = true;  // print each turn's principal variation
+  int matchGames = 0;  // when > 0, play this engine against matchReference
+  std::string matchReference = "selective";  // the reference lacks: "selective" (null move/ProbCut) or "quiescence"
+  std::string boardSuitePath;  // when set, run once per "name|board" line instead of --board
 };
 
 struct AggregateStats {
@@ -45,9 +65,22 @@ struct AggregateStats {
   long long ttHits = 0;
   long long ttExacts = 0;
   long long ttCuts = 0;
+  long long aspirationFailHighs = 0;
+  long long aspirationFailLows = 0;
+  long long nullMoveCuts = 0;
+  long long probcutCuts = 0;
+  long long winInOneCuts = 0;
+  long long quiescenceNodes = 0;
+  long long proofNodes = 0;
+  long long provenTurns = 0;  // turns (or --solve-bench positions) decided by a proof
+  long long hardDeadlineStops = 0;  // depth abandoned at the deadline
+  long long earlyStops = 0;  // predicted overrun, soft deadline or stable move
   long long legalMoves = 0;
   double moveSeconds = 0.0;
   int deepestCompletedDepth = 0;
+  int matchWins = 0;
+  int matchLosses = 0;
+  int matchDraws = 0;
 
   void record(const Minimax<WordBaseState, WordBaseMove>::SearchStats& stats, int moveCount) {
     ++turns;
@@ -57,10 +90,53 @@ struct AggregateStats {
     ttHits += stats.tt_hits;
     ttExacts += stats.tt_exacts;
     ttCuts += stats.tt_cuts;
+    aspirationFailHighs += stats.aspiration_fail_highs;
+    aspirationFailLows += stats.aspiration_fail_lows;
+    nullMoveCuts += stats.null_move_cuts;
+    probcutCuts += stats.probcut_cuts;
+    winInOneCuts += stats.win_in_one_cuts;
+    quiescenceNodes += stats.quiescence_nodes;
+    proofNodes += stats.proof_nodes;
+    if (stats.proof_result != ProofResult::Unknown) {
+      ++provenTurns;
+    }
+    if (stats.stop_reason == SearchStopReason::HardDeadline) {
+      ++hardDeadlineStops;
+    } else if (stats.stop_reason != SearchStopReason::DepthLimit
+               && stats.stop_reason != SearchStopReason::Proven) {
+      ++earlyStops;
+    }
     legalMoves += moveCount;
     moveSeconds += stats.elapsed_seconds;
     deepestCompletedDepth = std::max(deepestCompletedDepth, stats.max_depth);
   }
+
+  // Fold one board's results into a --board-suite total.
+  void add(const AggregateStats& other) {
+    turns += other.turns;
+    nodes += other.nodes;
+    leafs += other.leafs;
+    betaCuts += other.betaCuts;
+    ttHits += other.ttHits;
+    ttExacts += other.ttExacts;
+    ttCuts += other.ttCuts;
+    aspirationFailHighs += other.aspirationFailHighs;
+    aspirationFailLows += other.aspirationFailLows;
+    nullMoveCuts += other.nullMoveCuts;
+    probcutCuts += other.probcutCuts;
+    winInOneCuts += other.winInOneCuts;
+    quiescenceNodes += other.quiescenceNodes;
+    proofNodes += other.proofNodes;
+    provenTurns += other.provenTurns;
+    hardDeadlineStops += other.hardDeadlineStops;
+    earlyStops += other.earlyStops;
+    legalMoves += other.legalMoves;
+    moveSeconds += other.moveSeconds;
+    deepestCompletedDepth = std::max(deepestCompletedDepth, other.deepestCompletedDepth);
+    matchWins += other.matchWins;
+    matchLosses += other.matchLosses;
+    matchDraws += other.matchDraws;
+  }
 };
 
 void printUsage(const char* argv0) {
@@ -68,7 +144,9 @@ void printUsage(const char* argv0) {
     << "Usage: " << argv0 << " [dictionary-path] [options]\n"
     << "Options:\n"
     << "  --board <text>           Board text to play\n"
-    << "  --seconds <value>        Time budget per move (default 0.25)\n"
+    << "  --seconds <value>        Time budget per move, the hard deadline (default 0.25)\n"
+    << "  --soft-seconds <value>   Soft deadline: no new depth starts after it (default: --seconds)\n"
+    << "  --no-time-manager        Deepen until the hard deadline, without prediction or early stops\n"
     << "  --max-moves <count>      Max legal moves searched per position (default 200)\n"
     << "  --max-depth <depth>      Max iterative deepening depth (default 4)\n"
     << "  --max-turns <count>      Stop after this many plies (default 200)\n"
@@ -79,8 +157,48 @@ void printUsage(const char* argv0) {
     << "  --no-tt                  Disable the transposition table\n"
     << "  --print-boards           Print the board after each move\n"
     << "  --threads <N>            Number of search threads (default 1)\n"
-    << "  --parallel-mode <mode>   Parallel strategy: root, lazysmp, ybwc\n"
-    << "  --tt-bits <N>            TT size = 2^N entries (default 18, ~7MB)\n"
+    << "  --parallel-mode <mode>   Parallel strategy: root, lazysmp, ybwc, abdada\n"
+    << "  --no-helper-diversity    Lazy SMP/ABDADA helpers search exactly like the main thread\n"
+    << "  --tt-bits <N>            TT size = 2^N 8-byte entries (default 18, 2MB)\n"
+    << "  --tt-mb <N>              TT size in megabytes (rounded down to a power of two; overrides --tt-bits)\n"
+    << "  --no-huge-pages          Back the TT with normal 4KB pages\n"
+    << "  --tt-probe-bench <n>     Time n TT probes with and without prefetch, then exit\n"
+    << "  --tt-entry <layout>      TT entry layout: packed (8 bytes, default) or wide (16 bytes)\n"
+    << "  --engine <kind>          runtime (default) or static: TT use, evaluator and tracing fixed at compile time\n"
+    << "  --no-aspiration          Search every depth with a full (-INF, INF) window\n"
+    << "  --aspiration-width <N>   Initial aspiration half-width (default 40)\n"
+    << "  --aspiration-growth <N>  Window growth factor on fail-high/low (default 4)\n"
+    << "  --no-null-move           Disable null-move pruning\n"
+    << "  --null-move-reduction <N> Extra depth reduction of the null-move search (default 2)\n"
+    << "  --null-move-min-depth <N> Minimum remaining depth for null-move pruning (default 3)\n"
+    << "  --no-probcut             Disable ProbCut\n"
+    << "  --probcut-margin <N>     ProbCut margin above beta (default 200)\n"
+    << "  --probcut-reduction <N>  Depth reduction of the ProbCut search (default 3)\n"
+    << "  --probcut-min-depth <N>  Minimum remaining depth for ProbCut (default 5)\n"
+    << "  --no-win-in-one          Disable the win-in-one check at interior nodes\n"
+    << "  --no-forced-defence      Disable move restriction when the enemy threatens a win\n"
+    << "  --multi-pv <K>           Search the K best root moves with exact scores and print their lines\n"
+    << "  --no-pv                  Do not extract or print each turn's principal variation\n"
+    << "  --quiescence             Search captures below depth 0 instead of returning the static eval\n"
+    << "  --quiescence-ply <N>     Max capture plies below the horizon (default 4)\n"
+    << "  --quiescence-captures <N> Captures tried per quiescence node (default 8)\n"
+    << "  --quiescence-budget <N>  Capture nodes per horizon node (default 64)\n"
+    << "  --no-solver              Never hand race positions to the proof-number solver\n"
+    << "  --solver-race <rows>     Solve positions where a side is this many rows from winning (default 3)\n"
+    << "  --solver-nodes <N>       Positions the solver may generate per move (default 200000)\n"
+    << "  --solver-ply <N>         Solver horizon in plies (default 5)\n"
+    << "  --solve-bench            Play each game without the solver and time it on every race position\n"
+    << "  --widening               Cap each node's moves by ply, depth and node type instead of --max-moves\n"
+    << "  --width-root <N|all>     Root move cap with --widening (default all)\n"
+    << "  --width-pv <N>           PV-node move cap below the root (default 200)\n"
+    << "  --width-cut <N>          Other nodes' move cap below the root (default 200)\n"
+    << "  --width-taper <N>        Cap reduction per ply below the first (default 20)\n"
+    << "  --width-depth-bonus <N>  Cap increase per remaining ply above the last (default 0)\n"
+    << "  --width-min <N>          Smallest cap of any node below the root (default 40)\n"
+    << "  --match-games <n>        Play n games against the same engine minus --match-reference\n"
+    << "  --match-reference <what> What the reference lacks: selective (null-move/ProbCut, default), quiescence\n"
+    << "                           or widening (it uses --max-moves everywhere)\n"
+    << "  --board-suite <path>     Run on every name|board line of a suite file (e.g. scripts/benchmark-board-suite.txt)\n"
     ;
 }
 
@@ -98,6 +216,10 @@ PerfOptions parseArgs(int argc, char** argv) {
       options.boardText = argv[index++];
     } else if (arg == "--seconds" && index < argc) {
       options.maxSecondsPerMove = std::stod(argv[index++], nullptr);
+    } else if (arg == "--soft-seconds" && index < argc) {
+      options.softSecondsPerMove = std::stod(argv[index++], nullptr);
+    } else if (arg == "--no-time-manager") {
+      options.time.enabled = false;
     } else if (arg == "--max-moves" && index < argc) {
       options.maxMovesPerPosition = std::stoi(argv[index++], nullptr, 0);
     } else if (arg == "--max-depth" && index < argc) {
@@ -120,8 +242,87 @@ PerfOptions parseArgs(int argc, char** argv) {
       options.threads = std::stoi(argv[index++], nullptr, 0);
     } else if (arg == "--parallel-mode" && index < argc) {
       options.parallelMode = argv[index++];
+    } else if (arg == "--no-helper-diversity") {
+      options.diversifyHelpers = false;
     } else if (arg == "--tt-bits" && index < argc) {
       options.ttBits = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--tt-mb" && index < argc) {
+      options.ttMB = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--no-huge-pages") {
+      options.ttHugePages = false;
+    } else if (arg == "--tt-probe-bench" && index < argc) {
+      options.ttProbeBench = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--tt-entry" && index < argc) {
+      options.ttEntry = argv[index++];
+    } else if (arg == "--engine" && index < argc) {
+      options.engine = argv[index++];
+    } else if (arg == "--no-aspiration") {
+      options.aspiration.enabled = false;
+    } else if (arg == "--aspiration-width" && index < argc) {
+      options.aspiration.initial_width = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--aspiration-growth" && index < argc) {
+      options.aspiration.growth_factor = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--no-null-move") {
+      options.selective.null_move = false;
+    } else if (arg == "--null-move-reduction" && index < argc) {
+      options.selective.null_move_reduction = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--null-move-min-depth" && index < argc) {
+      options.selective.null_move_min_depth = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--no-probcut") {
+      options.selective.probcut = false;
+    } else if (arg == "--probcut-margin" && index < argc) {
+      options.selective.probcut_margin = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--probcut-reduction" && index < argc) {
+      options.selective.probcut_reduction = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--probcut-min-depth" && index < argc) {
+      options.selective.probcut_min_depth = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--no-win-in-one") {
+      options.selective.win_in_one = false;
+    } else if (arg == "--no-forced-defence") {
+      options.selective.forced_defence = false;
+    } else if (arg == "--multi-pv" && index < argc) {
+      options.multiPV = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--no-pv") {
+      options.trackPV = false;
+    } else if (arg == "--quiescence") {
+      options.quiescence.enabled = true;
+    } else if (arg == "--quiescence-ply" && index < argc) {
+      options.quiescence.max_ply = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--quiescence-captures" && index < argc) {
+      options.quiescence.max_captures = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--quiescence-budget" && index < argc) {
+      options.quiescence.node_budget = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--no-solver") {
+      options.solver.enabled = false;
+    } else if (arg == "--solver-race" && index < argc) {
+      options.solver.race_distance = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--solver-nodes" && index < argc) {
+      options.solver.max_nodes = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--solver-ply" && index < argc) {
+      options.solver.max_ply = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--solve-bench") {
+      options.solveBench = true;
+    } else if (arg == "--widening") {
+      options.width.enabled = true;
+    } else if (arg == "--width-root" && index < argc) {
+      const std::string value = argv[index++];
+      options.width.root_moves = value == "all" ? INF : std::stoi(value, nullptr, 0);
+    } else if (arg == "--width-pv" && index < argc) {
+      options.width.pv_moves = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--width-cut" && index < argc) {
+      options.width.cut_moves = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--width-taper" && index < argc) {
+      options.width.taper_per_ply = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--width-depth-bonus" && index < argc) {
+      options.width.depth_bonus = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--width-min" && index < argc) {
+      options.width.min_moves = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--match-games" && index < argc) {
+      options.matchGames = std::stoi(argv[index++], nullptr, 0);
+    } else if (arg == "--match-reference" && index < argc) {
+      options.matchReference = argv[index++];
+    } else if (arg == "--board-suite" && index < argc) {
+      options.boardSuitePath = argv[index++];
     } else {
       printUsage(argv[0]);
       throw std::invalid_argument("Unknown or incomplete argument: " + arg);
@@ -143,14 +344,72 @@ PerfOptions parseArgs(int argc, char** argv) {
   if (options.threads < 1) {
     throw std::invalid_argument("--threads must be >= 1");
   }
+  if (options.ttMB < 0) {
+    throw std::invalid_argument("--tt-mb must be non-negative");
+  }
+  if (options.ttMB > 0) {
+    options.ttBits = static_cast<int>(TranspositionTable<WordBaseMove>::size_bits_for_mb(options.ttMB));
+  }
+  if (options.ttProbeBench < 0) {
+    throw std::invalid_argument("--tt-probe-bench must be non-negative");
+  }
   if (options.ttBits < 10 || options.ttBits > 28) {
-    throw std::invalid_argument("--tt-bits must be between 10 and 28");
+    throw std::invalid_argument("--tt-bits must be between 10 and 28 (--tt-mb between 1 and 2048)");
+  }
+  if (options.ttEntry != "packed" && options.ttEntry != "wide") {
+    throw std::invalid_argument("--tt-entry must be packed or wide");
+  }
+  if (options.engine != "runtime" && options.engine != "static") {
+    throw std::invalid_argument("--engine must be runtime or static");
+  }
+  if (options.aspiration.initial_width < 1) {
+    throw std::invalid_argument("--aspiration-width must be >= 1");
+  }
+  if (options.aspiration.growth_factor < 2) {
+    throw std::invalid_argument("--aspiration-growth must be >= 2");
+  }
+  if (options.selective.null_move_reduction < 0 || options.selective.null_move_min_depth < 1) {
+    throw std::invalid_argument("--null-move-reduction must be >= 0 and --null-move-min-depth >= 1");
+  }
+  if (options.selective.probcut_reduction < 1
+      || options.selective.probcut_min_depth <= options.selective.probcut_reduction) {
+    throw std::invalid_argument("--probcut-reduction must be >= 1 and below --probcut-min-depth");
+  }
+  if (options.multiPV < 1) {
+    throw std::invalid_argument("--multi-pv must be >= 1");
+  }
+  if (options.quiescence.max_ply < 1 || options.quiescence.max_captures < 1
+      || options.quiescence.node_budget < 1) {
+    throw std::invalid_argument("--quiescence-ply, --quiescence-captures and --quiescence-budget must be >= 1");
+  }
+  if (options.solver.race_distance < 0 || options.solver.max_nodes < 1
+      || options.solver.max_ply < 1 || options.solver.max_ply > 63) {
+    throw std::invalid_argument("--solver-race must be >= 0, --solver-nodes >= 1 and --solver-ply between 1 and 63");
+  }
+  if (options.matchGames < 0) {
+    throw std::invalid_argument("--match-games must be non-negative");
+  }
+  if (options.width.root_moves < 1 || options.width.pv_moves < 1 || options.width.cut_moves < 1
+      || options.width.min_moves < 1 || options.width.taper_per_ply < 0 || options.width.depth_bonus < 0) {
+    throw std::invalid_argument("--width-root, --width-pv, --width-cut and --width-min must be >= 1, "
+                                "--width-taper and --width-depth-bonus >= 0");
+  }
+  if (options.matchReference != "selective" && options.matchReference != "quiescence"
+      && options.matchReference != "widening") {
+    throw std::invalid_argument("--match-reference must be selective, quiescence or widening");
+  }
+  if (options.matchReference == "widening" && !options.width.enabled) {
+    throw std::invalid_argument("--match-reference widening needs --widening");
+  }
+  if (options.matchReference == "quiescence" && !options.quiescence.enabled) {
+    throw std::invalid_argument("--match-reference quiescence needs --quiescence");
   }
   if (!options.parallelMode.empty() &&
       options.parallelMode != "root" &&
       options.parallelMode != "lazysmp" &&
-      options.parallelMode != "ybwc") {
-    throw std::invalid_argument("--parallel-mode must be root, lazysmp, or ybwc");
+      options.parallelMode != "ybwc" &&
+      options.parallelMode != "abdada") {
+    throw std::invalid_argument("--parallel-mode must be root, lazysmp, ybwc, or abdada");
   }
 
   return options;
@@ -228,6 +487,16 @@ void printSummary(const WordBaseState& state,
     << " total_tt_hits=" << aggregateStats.ttHits
     << " total_tt_exacts=" << aggregateStats.ttExacts
     << " total_tt_cuts=" << aggregateStats.ttCuts
+    << " total_aspiration_fail_highs=" << aggregateStats.aspirationFailHighs
+    << " total_aspiration_fail_lows=" << aggregateStats.aspirationFailLows
+    << " total_null_move_cuts=" << aggregateStats.nullMoveCuts
+    << " total_probcut_cuts=" << aggregateStats.probcutCuts
+    << " total_win_in_one_cuts=" << aggregateStats.winInOneCuts
+    << " total_quiescence_nodes=" << aggregateStats.quiescenceNodes
+    << " total_proof_nodes=" << aggregateStats.proofNodes
+    << " total_proven_turns=" << aggregateStats.provenTurns
+    << " total_hard_deadline_stops=" << aggregateStats.hardDeadlineStops
+    << " total_early_stops=" << aggregateStats.earlyStops
     << " avg_legal_moves=" << (aggregateStats.turns == 0 ? 0.0 : static_cast<double>(aggregateStats.legalMoves) / aggregateStats.turns)
     << " avg_nodes_per_turn=" << (aggregateStats.turns == 0 ? 0.0 : static_cast<double>(aggregateStats.nodes) / aggregateStats.turns)
     << " avg_seconds_per_turn=" << (aggregateStats.turns == 0 ? 0.0 : aggregateStats.moveSeconds / aggregateStats.turns)
@@ -236,259 +505,581 @@ void printSummary(const WordBaseState& state,
     << std::endl;
 }
 
-}  // namespace
+// Time dependent TT probes (each probe's key depends on the previous
+// result, as in search) over a full table of random positions: once plain,
+// once prefetching the next probe's bucket a step ahead, the way search
+// prefetches the child's bucket right after make_move.
+template<class Entry>
+void runProbeBench(const PerfOptions& options) {
+  TranspositionTable<WordBaseMove, Entry> tt(options.ttBits, options.ttHugePages);
+  tt.new_search();
+  std::mt19937_64 rng(12345);
+  WordBaseMove move;
+  move.mLegalWordId = 1;
+  for (size_t i = 0; i < tt.capacity(); i++) {
+    const uint64_t key = rng();
+    tt.store(key, key, Entry(move, key, 1, 0, TTEntryType::EXACT_VALUE));
+  }
 
-int main(int argc, char** argv) {
-  START_EASYLOGGINGPP(argc, argv);
+  std::vector<uint64_t> keys(options.ttProbeBench + 1);
+  for (auto& key : keys) key = rng();
 
-  try {
-    el::Configurations loggingConfig;
-    loggingConfig.setToDefault();
-    loggingConfig.setGlobally(el::ConfigurationType::ToFile, "false");
-    loggingConfig.set(el::Level::Debug, el::ConfigurationType::Enabled, "false");
-    loggingConfig.set(el::Level::Verbose, el::ConfigurationType::Enabled, "false");
-    loggingConfig.set(el::Level::Trace, el::ConfigurationType::Enabled, "false");
-    el::Loggers::reconfigureAllLoggers(loggingConfig);
+  auto timeProbes = [&](bool prefetch) {
+    Entry entry;
+    uint64_t key = keys[0];
+    Timer timer;
+    timer.start();
+    for (int i = 0; i < options.ttProbeBench; i++) {
+      if (prefetch) tt.prefetch(keys[i + 1]);
+      const uint64_t hit = tt.probe(key, key, entry);
+      key = keys[i + 1] ^ hit;
+    }
+    const double seconds = timer.seconds_elapsed();
+    volatile uint64_t sink = key;  // keep the probe chain observable
+    (void)sink;
+    return seconds * 1e9 / options.ttProbeBench;
+  };
 
-    PerfOptions options = parseArgs(argc, argv);
+  timeProbes(false);  // fault in and warm the TLB/cache state once
+  const double plainNs = timeProbes(false);
+  const double prefetchedNs = timeProbes(true);
+  std::cout
+    << "tt_probe_bench probes=" << options.ttProbeBench
+    << " tt_entry=" << options.ttEntry
+    << " tt_bytes=" << tt.size_bytes()
+    << " tt_pages=" << tt_page_mode_name(tt.page_mode())
+    << " ns_per_probe=" << plainNs
+    << " ns_per_probe_prefetched=" << prefetchedNs
+    << std::endl;
+}
 
-    std::ifstream input(options.dictionaryPath);
-    if (!input.is_open()) {
-      throw std::runtime_error("Could not open dictionary file: \"" + options.dictionaryPath + "\"");
+// Everything after board setup, for one TT entry layout and one
+// MinimaxPolicy (the parallel modes always use the runtime one). Returns
+// the measured stats so --board-suite can total them.
+template<class Entry, class Policy>
+AggregateStats runPerf(const PerfOptions& options, BoardStatic& board, WordBaseState& state) {
+  if (options.ttProbeBench > 0) {
+    runProbeBench<Entry>(options);
+    return {};
+  }
+
+  using SelectiveConfig = Minimax<WordBaseState, WordBaseMove>::SelectiveConfig;
+  using QuiescenceConfig = Minimax<WordBaseState, WordBaseMove>::QuiescenceConfig;
+  using WidthConfig = Minimax<WordBaseState, WordBaseMove>::WidthConfig;
+  auto makeAlgorithm = [&options](const SelectiveConfig& selective, const QuiescenceConfig& quiescence,
+                                  const WidthConfig& width) {
+    MinimaxEngine<WordBaseState, WordBaseMove, Entry, Policy> algorithm(options.maxSecondsPerMove, options.maxMovesPerPosition);
+    algorithm.setMaxDepth(options.maxDepth);
+    algorithm.setUseTranspositionTable(options.useTranspositionTable);
+    algorithm.setTTHugePages(options.ttHugePages);
+    algorithm.setTTSizeBits(options.ttBits);
+    algorithm.setTraceStream(nullptr);
+    algorithm.setAspirationConfig(options.aspiration);
+    algorithm.setSelectiveConfig(selective);
+    algorithm.setQuiescenceConfig(quiescence);
+    algorithm.setWidthConfig(width);
+    algorithm.setSolverConfig(options.solver);
+    algorithm.setSoftSeconds(options.softSecondsPerMove);
+    algorithm.setTimeConfig(options.time);
+    algorithm.setMultiPV(options.multiPV);
+    algorithm.setTrackPV(options.trackPV);
+    return algorithm;
+  };
+
+  // Strength A/B: this engine against a reference that differs only in
+  // having null-move pruning and ProbCut off, quiescence off, or widening
+  // off (--match-reference), alternating who moves first. Fixed-depth searches
+  // are deterministic, so use a board suite (or a time limit) for more than
+  // two distinct games per board.
+  if (options.matchGames > 0) {
+    SelectiveConfig referenceSelective = options.selective;
+    QuiescenceConfig referenceQuiescence = options.quiescence;
+    WidthConfig referenceWidth = options.width;
+    if (options.matchReference == "quiescence") {
+      referenceQuiescence.enabled = false;
+    } else if (options.matchReference == "widening") {
+      referenceWidth.enabled = false;
+    } else {
+      referenceSelective.null_move = false;
+      referenceSelective.probcut = false;
     }
+    AggregateStats matchStats;
+    long long referenceNodes = 0;
+    for (int gameIndex = 0; gameIndex < options.matchGames; ++gameIndex) {
+      auto candidate = makeAlgorithm(options.selective, options.quiescence, options.width);
+      auto baseline = makeAlgorithm(referenceSelective, referenceQuiescence, referenceWidth);
+      const char candidatePlayer = (gameIndex % 2 == 0) ? PLAYER_1 : PLAYER_2;
+      WordBaseState gameState(&board, PLAYER_1);
+      int ply = 0;
+      for (; ply < options.maxTurns && !gameState.is_terminal(); ++ply) {
+        const int legalMoveCount = gameState.count_legal_moves(gameState.player_to_move);
+        if (legalMoveCount == 0) {
+          break;
+        }
+        WordBaseState searchState(gameState);
+        if (gameState.player_to_move == candidatePlayer) {
+          WordBaseMove move = candidate.get_move(&searchState);
+          matchStats.record(candidate.getLastSearchStats(), legalMoveCount);
+          gameState.make_move(move);
+        } else {
+          WordBaseMove move = baseline.get_move(&searchState);
+          referenceNodes += baseline.getLastSearchStats().nodes;
+          gameState.make_move(move);
+        }
+      }
 
-    WordDictionary dictionary(input);
-    BoardStatic board(options.boardText, dictionary);
-    WordBaseState state(&board, PLAYER_1);
-
-    auto makeAlgorithm = [&options]() {
-      Minimax<WordBaseState, WordBaseMove> algorithm(options.maxSecondsPerMove, options.maxMovesPerPosition);
-      algorithm.setMaxDepth(options.maxDepth);
-      algorithm.setUseTranspositionTable(options.useTranspositionTable);
-      algorithm.setTTSizeBits(options.ttBits);
-      algorithm.setTraceStream(nullptr);
-      return algorithm;
-    };
-
-    if (options.selfplayGames > 0) {
-      std::ofstream out(options.selfplayOutPath);
-      if (!out.is_open()) {
-        throw std::runtime_error("Could not open selfplay output: \"" + options.selfplayOutPath + "\"");
+      const char referencePlayer = gameState.get_enemy(candidatePlayer);
+      const char* result = "draw";
+      if (gameState.is_winner(candidatePlayer)) {
+        ++matchStats.matchWins;
+        result = "win";
+      } else if (gameState.is_winner(referencePlayer)) {
+        ++matchStats.matchLosses;
+        result = "loss";
+      } else {
+        ++matchStats.matchDraws;
       }
+      std::cout
+        << "match_game " << gameIndex + 1
+        << " candidate_player " << int(candidatePlayer)
+        << " plies " << ply
+        << " result " << result
+        << std::endl;
+    }
 
-      for (int gameIndex = 0; gameIndex < options.selfplayGames; ++gameIndex) {
-        auto algorithm = makeAlgorithm();
-        WordBaseState gameState(&board, PLAYER_1);
-        for (int ply = 0; ply < options.maxTurns && !gameState.is_terminal(); ++ply) {
-          std::vector<WordBaseMove> legalMoves = gameState.get_legal_moves(options.maxMovesPerPosition);
-          if (legalMoves.empty()) {
-            break;
-          }
-
-          WordBaseState searchState(gameState);
-          Timer moveTimer;
-          moveTimer.start();
-          WordBaseMove move = algorithm.get_move(&searchState);
-          double moveSeconds = moveTimer.seconds_elapsed();
-          const auto& searchStats = algorithm.getLastSearchStats();
-          const LegalWord& legalWord = board.getLegalWord(move.mLegalWordId);
-
-          // Build move_scores JSON array from root move evaluations
-          const auto& rootScores = algorithm.getLastRootScores();
-          std::string moveScoresJson = "[";
-          for (size_t si = 0; si < rootScores.size(); ++si) {
-            const auto& rs = rootScores[si];
-            const LegalWord& rsWord = board.getLegalWord(rs.move.mLegalWordId);
-            if (si > 0) moveScoresJson += ",";
-            moveScoresJson += "[";
-            moveScoresJson += std::to_string(rs.score);
-            moveScoresJson += ",\"";
-            moveScoresJson += serializePath(rsWord.mWordSequence);
-            moveScoresJson += "\"]";
-          }
-          moveScoresJson += "]";
-
-          out
-            << "{"
-            << "\"type\":\"move\","
-            << "\"game\":" << gameIndex << ","
-            << "\"ply\":" << ply << ","
-            << "\"player\":" << int(gameState.player_to_move) << ","
-            << "\"board\":\"" << jsonEscape(options.boardText) << "\","
-            << "\"owners\":\"" << serializeOwners(gameState) << "\","
-            << "\"word\":\"" << jsonEscape(legalWord.mWord) << "\","
-            << "\"path\":\"" << serializePath(legalWord.mWordSequence) << "\","
-            << "\"legal_moves\":" << legalMoves.size() << ","
-            << "\"depth\":" << searchStats.max_depth << ","
-            << "\"nodes\":" << searchStats.nodes << ","
-            << "\"leafs\":" << searchStats.leafs << ","
-            << "\"beta_cuts\":" << searchStats.beta_cuts << ","
-            << "\"tt_hits\":" << searchStats.tt_hits << ","
-            << "\"nps\":" << searchStats.nodes_per_second << ","
-            << "\"seconds\":" << moveSeconds << ","
-            << "\"score\":" << searchStats.goodness << ","
-            << "\"move_scores\":" << moveScoresJson
-            << "}"
-            << "\n";
+    const int games = matchStats.matchWins + matchStats.matchLosses + matchStats.matchDraws;
+    std::cout
+      << "match games=" << games
+      << " wins=" << matchStats.matchWins
+      << " losses=" << matchStats.matchLosses
+      << " draws=" << matchStats.matchDraws
+      << " score=" << (games == 0 ? 0.0 : (matchStats.matchWins + 0.5 * matchStats.matchDraws) / games)
+      << " candidate_nodes=" << matchStats.nodes
+      << " reference_nodes=" << referenceNodes
+      << " candidate_null_move_cuts=" << matchStats.nullMoveCuts
+      << " candidate_probcut_cuts=" << matchStats.probcutCuts
+      << " candidate_win_in_one_cuts=" << matchStats.winInOneCuts
+      << " candidate_quiescence_nodes=" << matchStats.quiescenceNodes
+      << std::endl;
+    return matchStats;
+  }
 
-          gameState.make_move(move);
+  // Solver benchmark: play the game with the plain engine and, at every
+  // position within --solver-race rows of a win, time the proof-number
+  // solver alone. Each position counts as one turn of the stats.
+  if (options.solveBench) {
+    auto algorithm = makeAlgorithm(options.selective, options.quiescence, options.width);
+    Minimax<WordBaseState, WordBaseMove>::SolverConfig solverOff = options.solver;
+    solverOff.enabled = false;
+    algorithm.setSolverConfig(solverOff);
+    ProofNumberConfig proofConfig;
+    proofConfig.max_nodes = options.solver.max_nodes;
+    proofConfig.max_ply = options.solver.max_ply;
+    ProofNumberSearch<WordBaseState, WordBaseMove> solver(proofConfig);
+    AggregateStats solveStats;
+    WordBaseState gameState(&board, PLAYER_1);
+    for (int ply = 0; ply < options.maxTurns && !gameState.is_terminal(); ++ply) {
+      const int legalMoveCount = gameState.count_legal_moves(gameState.player_to_move);
+      if (legalMoveCount == 0) {
+        break;
+      }
+      if (gameState.race_distance() <= options.solver.race_distance) {
+        WordBaseState solveState(gameState);
+        const auto outcome = solver.solve(&solveState);
+        ++solveStats.turns;
+        solveStats.proofNodes += outcome.nodes;
+        solveStats.moveSeconds += outcome.elapsed_seconds;
+        solveStats.legalMoves += legalMoveCount;
+        if (outcome.result != ProofResult::Unknown) {
+          ++solveStats.provenTurns;
         }
+        std::cout
+          << "solve ply " << ply + 1
+          << " player " << int(gameState.player_to_move)
+          << " race " << gameState.race_distance()
+          << " legal_moves " << legalMoveCount
+          << " result " << proof_result_name(outcome.result)
+          << " distance " << outcome.distance
+          << " move " << (outcome.result == ProofResult::Unknown ? "-" : board.getLegalWord(outcome.move.mLegalWordId).mWord)
+          << " nodes " << outcome.nodes
+          << " elapsed " << outcome.elapsed_seconds << "s"
+          << std::endl;
+      }
+      WordBaseState searchState(gameState);
+      gameState.make_move(algorithm.get_move(&searchState));
+    }
+    std::cout
+      << "solve_summary positions=" << solveStats.turns
+      << " proven=" << solveStats.provenTurns
+      << " total_proof_nodes=" << solveStats.proofNodes
+      << " total_seconds=" << solveStats.moveSeconds
+      << " avg_seconds=" << (solveStats.turns == 0 ? 0.0 : solveStats.moveSeconds / solveStats.turns)
+      << " winner=" << winnerText(gameState)
+      << std::endl;
+    return solveStats;
+  }
+
+  if (options.selfplayGames > 0) {
+    std::ofstream out(options.selfplayOutPath);
+    if (!out.is_open()) {
+      throw std::runtime_error("Could not open selfplay output: \"" + options.selfplayOutPath + "\"");
+    }
+
+    for (int gameIndex = 0; gameIndex < options.selfplayGames; ++gameIndex) {
+      auto algorithm = makeAlgorithm(options.selective, options.quiescence, options.width);
+      WordBaseState gameState(&board, PLAYER_1);
+      for (int ply = 0; ply < options.maxTurns && !gameState.is_terminal(); ++ply) {
+        const int legalMoveCount = gameState.count_legal_moves(gameState.player_to_move);
+        if (legalMoveCount == 0) {
+          break;
+        }
+
+        WordBaseState searchState(gameState);
+        Timer moveTimer;
+        moveTimer.start();
+        WordBaseMove move = algorithm.get_move(&searchState);
+        double moveSeconds = moveTimer.seconds_elapsed();
+        const auto& searchStats = algorithm.getLastSearchStats();
+        const LegalWord& legalWord = board.getLegalWord(move.mLegalWordId);
+
+        // Build move_scores JSON array from root move evaluations
+        const auto& rootScores = algorithm.getLastRootScores();
+        std::string moveScoresJson = "[";
+        for (size_t si = 0; si < rootScores.size(); ++si) {
+          const auto& rs = rootScores[si];
+          const LegalWord& rsWord = board.getLegalWord(rs.move.mLegalWordId);
+          if (si > 0) moveScoresJson += ",";
+          moveScoresJson += "[";
+          moveScoresJson += std::to_string(rs.score);
+          moveScoresJson += ",\"";
+          moveScoresJson += serializePath(rsWord.mWordSequence);
+          moveScoresJson += "\"]";
+        }
+        moveScoresJson += "]";
 
         out
           << "{"
-          << "\"type\":\"summary\","
+          << "\"type\":\"move\","
           << "\"game\":" << gameIndex << ","
-          << "\"winner\":\"" << winnerText(gameState) << "\","
-          << "\"goodness\":" << gameState.get_goodness() << ","
-          << "\"terminal\":" << (gameState.is_terminal() ? "true" : "false")
+          << "\"ply\":" << ply << ","
+          << "\"player\":" << int(gameState.player_to_move) << ","
+          << "\"board\":\"" << jsonEscape(options.boardText) << "\","
+          << "\"owners\":\"" << serializeOwners(gameState) << "\","
+          << "\"word\":\"" << jsonEscape(legalWord.mWord) << "\","
+          << "\"path\":\"" << serializePath(legalWord.mWordSequence) << "\","
+          << "\"legal_moves\":" << legalMoveCount << ","
+          << "\"depth\":" << searchStats.max_depth << ","
+          << "\"nodes\":" << searchStats.nodes << ","
+          << "\"leafs\":" << searchStats.leafs << ","
+          << "\"beta_cuts\":" << searchStats.beta_cuts << ","
+          << "\"tt_hits\":" << searchStats.tt_hits << ","
+          << "\"aspiration_researches\":" << searchStats.aspiration_researches() << ","
+          << "\"nps\":" << searchStats.nodes_per_second << ","
+          << "\"seconds\":" << moveSeconds << ","
+          << "\"score\":" << searchStats.goodness << ","
+          << "\"move_scores\":" << moveScoresJson
           << "}"
           << "\n";
+
+        gameState.make_move(move);
       }
 
-      return 0;
+      out
+        << "{"
+        << "\"type\":\"summary\","
+        << "\"game\":" << gameIndex << ","
+        << "\"winner\":\"" << winnerText(gameState) << "\","
+        << "\"goodness\":" << gameState.get_goodness() << ","
+        << "\"terminal\":" << (gameState.is_terminal() ? "true" : "false")
+        << "}"
+        << "\n";
     }
 
-    auto algorithm = makeAlgorithm();
-
-    // Parallel search algorithm (created once, reused across turns).
-    using MmStats = Minimax<WordBaseState, WordBaseMove>::SearchStats;
-    std::unique_ptr<ParallelSearchBase<WordBaseState, WordBaseMove>> parallelAlgo;
-    if (options.threads > 1 && !options.parallelMode.empty()) {
-      if (options.parallelMode == "root") {
-        parallelAlgo = std::make_unique<RootParallelSearch<WordBaseState, WordBaseMove>>(
-          options.threads, options.maxSecondsPerMove, options.maxMovesPerPosition,
-          options.maxDepth, options.useTranspositionTable, options.ttBits);
-      } else if (options.parallelMode == "lazysmp") {
-        parallelAlgo = std::make_unique<LazySMPSearch<WordBaseState, WordBaseMove>>(
-          options.threads, options.maxSecondsPerMove, options.maxMovesPerPosition,
-          options.maxDepth, options.useTranspositionTable, options.ttBits);
-      } else if (options.parallelMode == "ybwc") {
-        parallelAlgo = std::make_unique<YBWCSearch<WordBaseState, WordBaseMove>>(
-          options.threads, options.maxSecondsPerMove, options.maxMovesPerPosition,
-          options.maxDepth, options.useTranspositionTable, options.ttBits);
-      }
-      std::cout << "parallel_mode=" << options.parallelMode
-                << " threads=" << options.threads << std::endl;
+    return {};
+  }
+
+  auto algorithm = makeAlgorithm(options.selective, options.quiescence, options.width);
+  const auto& tt = algorithm.getTranspositionTable();
+  std::cout << "engine=" << options.engine
+            << " tt_entry=" << options.ttEntry
+            << " entry_bytes=" << sizeof(Entry)
+            << " entries_per_bucket=" << TTBucket<Entry>::kEntries
+            << " tt_bytes=" << tt.size_bytes()
+            << " tt_pages=" << tt_page_mode_name(tt.page_mode()) << std::endl;
+
+  // Parallel search algorithm (created once, reused across turns).
+  using MmStats = MinimaxSearchStats<WordBaseMove>;
+  std::unique_ptr<ParallelSearchBase<WordBaseState, WordBaseMove, Entry>> parallelAlgo;
+  if (options.threads > 1 && !options.parallelMode.empty()) {
+    if (options.parallelMode == "root") {
+      parallelAlgo = std::make_unique<RootParallelSearch<WordBaseState, WordBaseMove, Entry>>(
+        options.threads, options.maxSecondsPerMove, options.maxMovesPerPosition,
+        options.maxDepth, options.useTranspositionTable, options.ttBits);
+    } else if (options.parallelMode == "lazysmp") {
+      parallelAlgo = std::make_unique<LazySMPSearch<WordBaseState, WordBaseMove, Entry>>(
+        options.threads, options.maxSecondsPerMove, options.maxMovesPerPosition,
+        options.maxDepth, options.useTranspositionTable, options.ttBits);
+    } else if (options.parallelMode == "ybwc") {
+      parallelAlgo = std::make_unique<YBWCSearch<WordBaseState, WordBaseMove, Entry>>(
+        options.threads, options.maxSecondsPerMove, options.maxMovesPerPosition,
+        options.maxDepth, options.useTranspositionTable, options.ttBits);
+    } else if (options.parallelMode == "abdada") {
+      parallelAlgo = std::make_unique<ABDADASearch<WordBaseState, WordBaseMove, Entry>>(
+        options.threads, options.maxSecondsPerMove, options.maxMovesPerPosition,
+        options.maxDepth, options.useTranspositionTable, options.ttBits);
     }
+    parallelAlgo->setAspirationConfig(options.aspiration);
+    parallelAlgo->setSelectiveConfig(options.selective);
+    parallelAlgo->setQuiescenceConfig(options.quiescence);
+    parallelAlgo->setWidthConfig(options.width);
+    parallelAlgo->setSolverConfig(options.solver);
+    parallelAlgo->setSoftSeconds(options.softSecondsPerMove);
+    parallelAlgo->setTimeConfig(options.time);
+    parallelAlgo->setTTHugePages(options.ttHugePages);
+    parallelAlgo->setMultiPV(options.multiPV);
+    parallelAlgo->setTrackPV(options.trackPV);
+    parallelAlgo->setDiversifyHelpers(options.diversifyHelpers);
+    std::cout << "parallel_mode=" << options.parallelMode
+              << " threads=" << options.threads << std::endl;
+  }
 
-    // Unified search dispatch: returns (move, stats).
-    auto doSearch = [&](WordBaseState& searchState) -> std::pair<WordBaseMove, MmStats> {
-      if (parallelAlgo) {
-        auto m = parallelAlgo->get_move(&searchState);
-        return {m, parallelAlgo->getLastSearchStats()};
-      } else {
-        auto m = algorithm.get_move(&searchState);
-        return {m, algorithm.getLastSearchStats()};
+  // Unified search dispatch: returns (move, stats).
+  auto doSearch = [&](WordBaseState& searchState) -> std::pair<WordBaseMove, MmStats> {
+    if (parallelAlgo) {
+      auto m = parallelAlgo->get_move(&searchState);
+      return {m, parallelAlgo->getLastSearchStats()};
+    } else {
+      auto m = algorithm.get_move(&searchState);
+      return {m, algorithm.getLastSearchStats()};
+    }
+  };
+
+  Timer gameTimer;
+  AggregateStats aggregateStats;
+  bool measuring = options.warmupTurns == 0;
+  bool measurementStarted = measuring;
+  if (measurementStarted) {
+    gameTimer.start();
+  }
+  int measuredTurns = 0;
+
+  int turn = 0;
+  while (turn < options.maxTurns && !state.is_terminal()) {
+    const int legalMoveCount = state.count_legal_moves(state.player_to_move);
+    if (legalMoveCount == 0) {
+      std::cout << "turn " << turn + 1 << " no legal moves remain" << std::endl;
+      break;
+    }
+
+    WordBaseState searchState(state);
+    Timer moveTimer;
+    moveTimer.start();
+    auto [move, searchStats] = doSearch(searchState);
+    double moveSeconds = moveTimer.seconds_elapsed();
+
+    if (measuring) {
+      aggregateStats.record(searchStats, legalMoveCount);
+    }
+
+    const LegalWord& legalWord = board.getLegalWord(move.mLegalWordId);
+    const bool isWarmupTurn = turn < options.warmupTurns;
+    std::cout
+      << (isWarmupTurn ? "warmup" : "turn")
+      << " " << turn + 1
+      << " player " << int(state.player_to_move)
+      << " move " << legalWord.mWord
+      << " path " << legalWord.mWordSequence
+      << " elapsed " << moveSeconds << "s"
+      << " legal_moves " << legalMoveCount
+      << " depth " << searchStats.max_depth
+      << " nodes " << searchStats.nodes
+      << " leafs " << searchStats.leafs
+      << " beta_cuts " << searchStats.beta_cuts
+      << " tt_hits " << searchStats.tt_hits
+      << " asp_researches " << searchStats.aspiration_researches()
+      << " stop " << search_stop_reason_name(searchStats.stop_reason)
+      << " nps " << searchStats.nodes_per_second;
+    for (size_t pvIndex = 0; pvIndex < searchStats.pv.size(); ++pvIndex) {
+      std::cout << (pvIndex == 0 ? " pv " : " ") << board.getLegalWord(searchStats.pv[pvIndex].mLegalWordId).mWord;
+    }
+    std::cout << std::endl;
+    const auto& rootLines = parallelAlgo ? parallelAlgo->getRootLines() : algorithm.getRootLines();
+    for (size_t lineIndex = 0; options.multiPV > 1 && lineIndex < rootLines.size(); ++lineIndex) {
+      std::cout << "  line " << lineIndex + 1 << " score " << rootLines[lineIndex].score << " pv";
+      for (const auto& pvMove : rootLines[lineIndex].pv) {
+        std::cout << " " << board.getLegalWord(pvMove.mLegalWordId).mWord;
       }
-    };
+      std::cout << std::endl;
+    }
 
-    Timer gameTimer;
-    AggregateStats aggregateStats;
-    bool measuring = options.warmupTurns == 0;
-    bool measurementStarted = measuring;
-    if (measurementStarted) {
+    state.make_move(move);
+    ++turn;
+    if (measuring) {
+      ++measuredTurns;
+    } else if (turn >= options.warmupTurns) {
+      measuring = true;
+      measurementStarted = true;
+      measuredTurns = 0;
+      aggregateStats = AggregateStats();
       gameTimer.start();
     }
-    int measuredTurns = 0;
 
-    int turn = 0;
-    while (turn < options.maxTurns && !state.is_terminal()) {
-      std::vector<WordBaseMove> legalMoves = state.get_legal_moves(options.maxMovesPerPosition);
-      if (legalMoves.empty()) {
-        std::cout << "turn " << turn + 1 << " no legal moves remain" << std::endl;
-        break;
-      }
+    if (options.printBoards) {
+      std::cout << state << std::endl;
+    }
+  }
 
-      WordBaseState searchState(state);
-      Timer moveTimer;
-      moveTimer.start();
-      auto [move, searchStats] = doSearch(searchState);
-      double moveSeconds = moveTimer.seconds_elapsed();
+  if (options.repeatSearches > 0) {
+    const int legalMoveCount = state.count_legal_moves(state.player_to_move);
+    if (legalMoveCount == 0) {
+      std::cout << "profile no legal moves remain after warmup" << std::endl;
+    } else {
+      AggregateStats repeatedSearchStats;
+      Timer repeatedSearchTimer;
+      repeatedSearchTimer.start();
+      for (int repeat = 0; repeat < options.repeatSearches; ++repeat) {
+        WordBaseState searchState(state);
+        Timer moveTimer;
+        moveTimer.start();
+        auto [move, searchStats] = doSearch(searchState);
+        double moveSeconds = moveTimer.seconds_elapsed();
+        repeatedSearchStats.record(searchStats, legalMoveCount);
 
-      if (measuring) {
-        aggregateStats.record(searchStats, legalMoves.size());
+        const LegalWord& legalWord = board.getLegalWord(move.mLegalWordId);
+        std::cout
+          << "profile " << repeat + 1
+          << " player " << int(state.player_to_move)
+          << " move " << legalWord.mWord
+          << " path " << legalWord.mWordSequence
+          << " elapsed " << moveSeconds << "s"
+          << " legal_moves " << legalMoveCount
+          << " depth " << searchStats.max_depth
+          << " nodes " << searchStats.nodes
+          << " leafs " << searchStats.leafs
+          << " beta_cuts " << searchStats.beta_cuts
+          << " tt_hits " << searchStats.tt_hits
+          << " asp_researches " << searchStats.aspiration_researches()
+          << " stop " << search_stop_reason_name(searchStats.stop_reason)
+          << " nps " << searchStats.nodes_per_second
+          << std::endl;
       }
 
-      const LegalWord& legalWord = board.getLegalWord(move.mLegalWordId);
-      const bool isWarmupTurn = turn < options.warmupTurns;
-      std::cout
-        << (isWarmupTurn ? "warmup" : "turn")
-        << " " << turn + 1
-        << " player " << int(state.player_to_move)
-        << " move " << legalWord.mWord
-        << " path " << legalWord.mWordSequence
-        << " elapsed " << moveSeconds << "s"
-        << " legal_moves " << legalMoves.size()
-        << " depth " << searchStats.max_depth
-        << " nodes " << searchStats.nodes
-        << " leafs " << searchStats.leafs
-        << " beta_cuts " << searchStats.beta_cuts
-        << " tt_hits " << searchStats.tt_hits
-        << " nps " << searchStats.nodes_per_second
-        << std::endl;
+      printSummary(state,
+                   repeatedSearchStats,
+                   options.repeatSearches,
+                   turn,
+                   options.warmupTurns,
+                   true,
+                   repeatedSearchTimer);
+      return repeatedSearchStats;
+    }
+  }
 
-      state.make_move(move);
-      ++turn;
-      if (measuring) {
-        ++measuredTurns;
-      } else if (turn >= options.warmupTurns) {
-        measuring = true;
-        measurementStarted = true;
-        measuredTurns = 0;
-        aggregateStats = AggregateStats();
-        gameTimer.start();
-      }
+  printSummary(state, aggregateStats, measuredTurns, turn, options.warmupTurns, measurementStarted, gameTimer);
+  return aggregateStats;
+}
 
-      if (options.printBoards) {
-        std::cout << state << std::endl;
-      }
+// Picks the engine instantiation for --engine (and --no-tt).
+template<class Entry>
+AggregateStats runEngine(const PerfOptions& options, BoardStatic& board, WordBaseState& state) {
+  if (options.engine == "runtime") {
+    return runPerf<Entry, RuntimeMinimaxPolicy>(options, board, state);
+  }
+  if (!options.useTranspositionTable) {
+    using NoTTPolicy = MinimaxPolicy<MinimaxTTMode::None, StateEvaluator, false>;
+    return runPerf<Entry, NoTTPolicy>(options, board, state);
+  }
+  return runPerf<Entry, LocalMinimaxPolicy>(options, board, state);
+}
+
+// One board of the run (the --board text, or a --board-suite entry).
+AggregateStats runBoard(const PerfOptions& options, WordDictionary& dictionary, const std::string& boardText) {
+  BoardStatic board(boardText, dictionary);
+  WordBaseState state(&board, PLAYER_1);
+
+  if (options.ttEntry == "wide") {
+    return runEngine<WideTTEntry<WordBaseMove>>(options, board, state);
+  }
+  return runEngine<TTEntry<WordBaseMove>>(options, board, state);
+}
+
+// Runs every "name|board_text" line of the suite file ('#' starts a
+// comment) and prints a suite-wide total for A/B comparisons.
+void runBoardSuite(const PerfOptions& options, WordDictionary& dictionary) {
+  std::ifstream suite(options.boardSuitePath);
+  if (!suite.is_open()) {
+    throw std::runtime_error("Could not open board suite: \"" + options.boardSuitePath + "\"");
+  }
+
+  AggregateStats suiteStats;
+  int boards = 0;
+  std::string line;
+  while (std::getline(suite, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
     }
+    const size_t separator = line.find('|');
+    if (separator == std::string::npos) {
+      throw std::runtime_error("Malformed board suite line: \"" + line + "\"");
+    }
+    std::cout << "suite_board " << line.substr(0, separator) << std::endl;
+    suiteStats.add(runBoard(options, dictionary, line.substr(separator + 1)));
+    ++boards;
+  }
 
-    if (options.repeatSearches > 0) {
-      std::vector<WordBaseMove> legalMoves = state.get_legal_moves(options.maxMovesPerPosition);
-      if (legalMoves.empty()) {
-        std::cout << "profile no legal moves remain after warmup" << std::endl;
-      } else {
-        AggregateStats repeatedSearchStats;
-        Timer repeatedSearchTimer;
-        repeatedSearchTimer.start();
-        for (int repeat = 0; repeat < options.repeatSearches; ++repeat) {
-          WordBaseState searchState(state);
-          Timer moveTimer;
-          moveTimer.start();
-          auto [move, searchStats] = doSearch(searchState);
-          double moveSeconds = moveTimer.seconds_elapsed();
-          repeatedSearchStats.record(searchStats, legalMoves.size());
-
-          const LegalWord& legalWord = board.getLegalWord(move.mLegalWordId);
-          std::cout
-            << "profile " << repeat + 1
-            << " player " << int(state.player_to_move)
-            << " move " << legalWord.mWord
-            << " path " << legalWord.mWordSequence
-            << " elapsed " << moveSeconds << "s"
-            << " legal_moves " << legalMoves.size()
-            << " depth " << searchStats.max_depth
-            << " nodes " << searchStats.nodes
-            << " leafs " << searchStats.leafs
-            << " beta_cuts " << searchStats.beta_cuts
-            << " tt_hits " << searchStats.tt_hits
-            << " nps " << searchStats.nodes_per_second
-            << std::endl;
-        }
+  const int games = suiteStats.matchWins + suiteStats.matchLosses + suiteStats.matchDraws;
+  std::cout
+    << "suite_summary boards=" << boards
+    << " turns=" << suiteStats.turns
+    << " total_nodes=" << suiteStats.nodes
+    << " avg_nodes_per_turn=" << (suiteStats.turns == 0 ? 0.0 : static_cast<double>(suiteStats.nodes) / suiteStats.turns)
+    << " total_seconds=" << suiteStats.moveSeconds
+    << " total_null_move_cuts=" << suiteStats.nullMoveCuts
+    << " total_probcut_cuts=" << suiteStats.probcutCuts
+    << " total_win_in_one_cuts=" << suiteStats.winInOneCuts
+    << " total_quiescence_nodes=" << suiteStats.quiescenceNodes
+    << " total_proof_nodes=" << suiteStats.proofNodes
+    << " total_proven=" << suiteStats.provenTurns
+    << " total_hard_deadline_stops=" << suiteStats.hardDeadlineStops
+    << " total_early_stops=" << suiteStats.earlyStops
+    << " deepest_completed_depth=" << suiteStats.deepestCompletedDepth;
+  if (games > 0) {
+    std::cout
+      << " match_wins=" << suiteStats.matchWins
+      << " match_losses=" << suiteStats.matchLosses
+      << " match_draws=" << suiteStats.matchDraws
+      << " match_score=" << (suiteStats.matchWins + 0.5 * suiteStats.matchDraws) / games;
+  }
+  std::cout << std::endl;
+}
 
-        printSummary(state,
-                     repeatedSearchStats,
-                     options.repeatSearches,
-                     turn,
-                     options.warmupTurns,
-                     true,
-                     repeatedSearchTimer);
-        return 0;
-      }
+}  // namespace
+
+int main(int argc, char** argv) {
+  START_EASYLOGGINGPP(argc, argv);
+
+  try {
+    el::Configurations loggingConfig;
+    loggingConfig.setToDefault();
+    loggingConfig.setGlobally(el::ConfigurationType::ToFile, "false");
+    loggingConfig.set(el::Level::Debug, el::ConfigurationType::Enabled, "false");
+    loggingConfig.set(el::Level::Verbose, el::ConfigurationType::Enabled, "false");
+    loggingConfig.set(el::Level::Trace, el::ConfigurationType::Enabled, "false");
+    el::Loggers::reconfigureAllLoggers(loggingConfig);
+
+    PerfOptions options = parseArgs(argc, argv);
+
+    std::ifstream input(options.dictionaryPath);
+    if (!input.is_open()) {
+      throw std::runtime_error("Could not open dictionary file: \"" + options.dictionaryPath + "\"");
     }
 
-    printSummary(state, aggregateStats, measuredTurns, turn, options.warmupTurns, measurementStarted, gameTimer);
+    WordDictionary dictionary(input);
+    if (!options.boardSuitePath.empty()) {
+      runBoardSuite(options, dictionary);
+    } else {
+      runBoard(options, dictionary, options.boardText);
+    }
   } catch (const std::exception& error) {
     std::cerr << error.what() << std::endl;
     return 1;
@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -12,6 +13,7 @@
 #include "word-dictionary.h"
 #include "wordescape.cpp"
 #include "parallel-search.h"
+#include "opening-book.h"
 
 INITIALIZE_EASYLOGGINGPP
 
@@ -52,6 +54,11 @@ int extractInt(const std::string& json, const std::string& key) {
   return static_cast<int>(extractDouble(json, key));
 }
 
+bool extractBool(const std::string& json, const std::string& key) {
+  auto pos = findValueStart(json, key);
+  return pos != std::string::npos && json.compare(pos, 4, "true") == 0;
+}
+
 std::vector<std::string> extractStringArray(const std::string& json, const std::string& key) {
   std::vector<std::string> result;
   auto pos = findValueStart(json, key);
@@ -85,6 +92,10 @@ std::string jsonEscape(const std::string& input) {
   return escaped;
 }
 
+// Pondering runs until the next request stops it; this only bounds a
+// forgotten session.
+constexpr double kPonderSeconds = 3600.0;
+
 }  // namespace
 
 int main(int argc, char** argv) {
@@ -103,7 +114,26 @@ int main(int argc, char** argv) {
     loggingConfig.set(el::Level::Warning, el::ConfigurationType::Enabled, "false");
     el::Loggers::reconfigureAllLoggers(loggingConfig);
 
-    std::string dictPath = (argc > 1) ? argv[1] : "twl06_with_wordbase_additions.txt";
+    // wordbase-server [dictionary] [--book <path>]...
+    int argIndex = 1;
+    std::string dictPath = "twl06_with_wordbase_additions.txt";
+    if (argIndex < argc && std::string(argv[argIndex]).rfind("--", 0) != 0) {
+      dictPath = argv[argIndex++];
+    }
+    // Opening books (see wordbase-book-build), keyed by board text.
+    std::map<std::string, OpeningBook> books;
+    while (argIndex < argc) {
+      const std::string arg = argv[argIndex++];
+      if (arg == "--book" && argIndex < argc) {
+        OpeningBook book = OpeningBook::load(argv[argIndex++]);
+        std::cerr << "Loaded opening book: " << book.size() << " entries" << std::endl;
+        books[book.boardText()] = std::move(book);
+      } else {
+        std::cerr << "Unknown or incomplete argument: " << arg << std::endl;
+        return 1;
+      }
+    }
+
     std::ifstream dictFile(dictPath);
     if (!dictFile.is_open()) {
       std::cerr << "Could not open dictionary: " << dictPath << std::endl;
@@ -119,18 +149,55 @@ int main(int argc, char** argv) {
     // Cache BoardStatic for the current board text (expensive to build).
     std::string cachedBoardText;
     std::unique_ptr<BoardStatic> cachedBoard;
+    const OpeningBook* cachedBook = nullptr;
+
+    // One engine per board, kept across requests so its shared TT and
+    // per-thread history tables carry over from turn to turn. A new board,
+    // or a different optional "game" id on the same board, starts fresh.
+    const int numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::unique_ptr<LazySMPSearch<WordBaseState, WordBaseMove>> algorithm;
+    std::string cachedGameId;
+
+    // Pondering (opt-in per request with "ponder": true). After answering,
+    // a background thread keeps searching the position after our move, from
+    // the opponent's side, so every reply gets searched at one ply less,
+    // until the next request arrives. Everything it finds lands in the
+    // engine's shared TT, so the next search starts warm either way. Its
+    // best move is the predicted reply: if the next request is exactly that
+    // position (a ponder hit) the deepest part of the pondered tree applies
+    // directly. On a miss only the shallower entries for the actual reply
+    // are there.
+    std::thread ponderThread;
+    std::unique_ptr<WordBaseState> ponderPosition;
+    WordBaseMove ponderReply;
+    bool ponderReplyValid = false;
+    auto stopPondering = [&]() {
+      if (!ponderThread.joinable()) return false;
+      // The stop ends the ponder search even if it has not started yet.
+      // If it had already returned, the stop is still pending; withdraw it
+      // so it does not end the next request's search.
+      algorithm->stop();
+      ponderThread.join();
+      algorithm->clear_stop();
+      return true;
+    };
 
     // Read JSON requests line by line from stdin.
     std::string line;
     while (std::getline(std::cin, line)) {
       if (line.empty()) continue;
+      const bool pondered = stopPondering();
 
       try {
         std::string boardText = extractString(line, "board");
         std::string owners = extractString(line, "owners");
         int player = extractInt(line, "player");
         double seconds = extractDouble(line, "seconds");
+        const double softSeconds = extractDouble(line, "soft_seconds");
         int maxDepth = extractInt(line, "depth");
+        std::string gameId = extractString(line, "game");
+        const bool ponder = extractBool(line, "ponder");
+        const int multiPV = std::max(1, extractInt(line, "multipv"));
         auto playedWords = extractStringArray(line, "played");
 
         if (boardText.size() != kBoardHeight * kBoardWidth) {
@@ -148,10 +215,20 @@ int main(int argc, char** argv) {
 
         // Create or reuse BoardStatic (word index).
         if (boardText != cachedBoardText) {
+          algorithm.reset();  // engine state refers to the old board's word ids
+          // So does the pondered position: drop it before its board goes.
+          ponderPosition.reset();
+          ponderReplyValid = false;
           cachedBoard = std::make_unique<BoardStatic>(boardText, dictionary);
           cachedBoardText = boardText;
           std::cerr << "Built BoardStatic: " << cachedBoard->getLegalWordsSize()
                     << " legal words" << std::endl;
+          auto book = books.find(boardText);
+          cachedBook = (book != books.end()) ? &book->second : nullptr;
+          if (cachedBook && !cachedBook->matches(*cachedBoard)) {
+            std::cerr << "Opening book was built with a different dictionary; ignoring it" << std::endl;
+            cachedBook = nullptr;
+          }
         }
 
         // Create initial state, then override ownership.
@@ -173,6 +250,19 @@ int main(int argc, char** argv) {
           state.addAlreadyPlayed(word);
         }
 
+        std::string ponderResult;
+        if (pondered) {
+          bool hit = false;
+          if (ponderReplyValid) {
+            WordBaseState expected(*ponderPosition);
+            expected.make_move(ponderReply);
+            hit = expected.player_to_move == state.player_to_move
+              && expected.hash() == state.hash()
+              && expected.tt_verification_key() == state.tt_verification_key();
+          }
+          ponderResult = hit ? "hit" : "miss";
+        }
+
         // Check terminal.
         if (state.is_terminal()) {
           std::cout << "{\"error\":\"game is terminal\"}" << std::endl;
@@ -183,39 +273,132 @@ int main(int argc, char** argv) {
         if (seconds <= 0) seconds = 2.0;
         if (maxDepth <= 0) maxDepth = 10;
 
-        int numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
-        LazySMPSearch<WordBaseState, WordBaseMove> algorithm(
-            numThreads, seconds, 200, maxDepth, true, 18);
-
-        WordBaseState searchState(state);
-        WordBaseMove move = algorithm.get_move(&searchState);
+        if (!algorithm) {
+          algorithm = std::make_unique<LazySMPSearch<WordBaseState, WordBaseMove>>(
+              numThreads, seconds, 200, maxDepth, true, 18);
+          cachedGameId = gameId;
+        } else if (!gameId.empty() && gameId != cachedGameId) {
+          algorithm->reset();
+          cachedGameId = gameId;
+        }
+        // "seconds" is the hard deadline; the optional "soft_seconds" is the
+        // time the client would like to spend (see MinimaxTimeConfig).
+        algorithm->setMaxSeconds(seconds);
+        algorithm->setSoftSeconds(softSeconds);
+        algorithm->setMaxDepth(maxDepth);
+        // "multipv": k > 1 also reports the k best moves with exact scores
+        // and their principal variations under "lines".
+        algorithm->setMultiPV(multiPV);
+
+        // A position in the opening book is answered without searching,
+        // unless the client asked for several scored lines.
+        WordBaseMove move;
+        OpeningBookEntry bookEntry;
+        const bool fromBook = multiPV == 1 && cachedBook && cachedBook->probe(state, bookEntry);
+        if (fromBook) {
+          move.mLegalWordId = bookEntry.move;
+        } else {
+          WordBaseState searchState(state);
+          move = algorithm->get_move(&searchState);
+        }
 
         const LegalWord& legalWord = cachedBoard->getLegalWord(move.mLegalWordId);
-        const auto& stats = algorithm.getLastSearchStats();
+        const auto& stats = algorithm->getLastSearchStats();
 
         // Build path JSON array: [[row, col], ...]
-        std::string pathJson = "[";
-        for (size_t i = 0; i < legalWord.mWordSequence.size(); i++) {
-          if (i > 0) pathJson += ",";
-          pathJson += "[" + std::to_string(legalWord.mWordSequence[i].first) + ","
-                        + std::to_string(legalWord.mWordSequence[i].second) + "]";
-        }
-        pathJson += "]";
+        auto pathJson = [](const LegalWord& word) {
+          std::string json = "[";
+          for (size_t i = 0; i < word.mWordSequence.size(); i++) {
+            if (i > 0) json += ",";
+            json += "[" + std::to_string(word.mWordSequence[i].first) + ","
+                    + std::to_string(word.mWordSequence[i].second) + "]";
+          }
+          return json + "]";
+        };
 
         std::cout << "{"
                   << "\"word\":\"" << jsonEscape(legalWord.mWord) << "\","
-                  << "\"path\":" << pathJson << ","
-                  << "\"depth\":" << stats.max_depth << ","
-                  << "\"nodes\":" << stats.nodes << ","
-                  << "\"nps\":" << static_cast<long long>(stats.nodes_per_second) << ","
-                  << "\"threads\":" << numThreads << ","
-                  << "\"seconds\":" << stats.elapsed_seconds
-                  << "}" << std::endl;
+                  << "\"path\":" << pathJson(legalWord) << ",";
+        if (fromBook) {
+          // "depth" and "score" are those of the offline search.
+          std::cout << "\"depth\":" << bookEntry.depth << ","
+                    << "\"nodes\":0,\"tt_hits\":0,\"nps\":0,"
+                    << "\"threads\":" << numThreads << ","
+                    << "\"seconds\":0,"
+                    << "\"stop\":\"book\","
+                    << "\"score\":" << bookEntry.score;
+        } else {
+          std::cout << "\"depth\":" << stats.max_depth << ","
+                    << "\"nodes\":" << stats.nodes << ","
+                    << "\"tt_hits\":" << stats.tt_hits << ","
+                    << "\"nps\":" << static_cast<long long>(stats.nodes_per_second) << ","
+                    << "\"threads\":" << numThreads << ","
+                    << "\"seconds\":" << stats.elapsed_seconds << ","
+                    << "\"stop\":\"" << search_stop_reason_name(stats.stop_reason) << "\"";
+          // The expected line, starting with "word".
+          std::cout << ",\"pv\":[";
+          for (size_t i = 0; i < stats.pv.size(); i++) {
+            std::cout << (i > 0 ? "," : "") << "\""
+                      << jsonEscape(cachedBoard->getLegalWord(stats.pv[i].mLegalWordId).mWord) << "\"";
+          }
+          std::cout << "]";
+        }
+        // Race positions the endgame solver decided: "win" or "loss" and the
+        // plies until the game ends.
+        if (!fromBook && stats.proof_result != ProofResult::Unknown) {
+          std::cout << ",\"proof\":\"" << proof_result_name(stats.proof_result) << "\""
+                    << ",\"proof_distance\":" << stats.proof_distance;
+        }
+        if (!ponderResult.empty()) {
+          std::cout << ",\"ponder\":\"" << ponderResult << "\"";
+        }
+        // [{"word":..., "path":..., "score":..., "pv":["word", ...]}, ...]
+        const auto& lines = algorithm->getRootLines();
+        if (multiPV > 1 && !lines.empty()) {
+          std::cout << ",\"lines\":[";
+          for (size_t i = 0; i < lines.size(); i++) {
+            const LegalWord& lineWord = cachedBoard->getLegalWord(lines[i].move.mLegalWordId);
+            std::cout << (i > 0 ? "," : "") << "{"
+                      << "\"word\":\"" << jsonEscape(lineWord.mWord) << "\","
+                      << "\"path\":" << pathJson(lineWord) << ","
+                      << "\"score\":" << lines[i].score << ","
+                      << "\"pv\":[";
+            for (size_t j = 0; j < lines[i].pv.size(); j++) {
+              std::cout << (j > 0 ? "," : "") << "\""
+                        << jsonEscape(cachedBoard->getLegalWord(lines[i].pv[j].mLegalWordId).mWord) << "\"";
+            }
+            std::cout << "]}";
+          }
+          std::cout << "]";
+        }
+        std::cout << "}" << std::endl;
+
+        // Ponder one ply deeper than this request searched, so the reply
+        // position gets a full-depth entry; the thread simply ends if that
+        // completes before the next request.
+        ponderPosition = std::make_unique<WordBaseState>(state);
+        ponderPosition->make_move(move);
+        ponderReplyValid = false;
+        if (ponder && !ponderPosition->is_terminal()) {
+          algorithm->setMaxSeconds(kPonderSeconds);
+          algorithm->setSoftSeconds(0.0);
+          algorithm->setMaxDepth(maxDepth + 1);
+          algorithm->setMultiPV(1);
+          ponderThread = std::thread([&, position = *ponderPosition]() mutable {
+            try {
+              ponderReply = algorithm->get_move(&position);
+              ponderReplyValid = algorithm->getLastSearchStats().max_depth > 0;
+            } catch (const std::exception& e) {
+              std::cerr << "ponder: " << e.what() << std::endl;
+            }
+          });
+        }
 
       } catch (const std::exception& e) {
         std::cout << "{\"error\":\"" << jsonEscape(e.what()) << "\"}" << std::endl;
       }
     }
+    stopPondering();
 
   } catch (const std::exception& error) {
     std::cerr << error.what() << std::endl;
@@ -1,7 +1,7 @@
 #include <string>
 
 struct WordBaseMove : public Move<WordBaseMove> {
-  LegalWordId mLegalWordId;
+  LegalWordId mLegalWordId = -1;
 
   WordBaseMove() { }
   WordBaseMove(const LegalWordId legalWordId) : mLegalWordId(legalWordId) { }
@@ -17,6 +17,7 @@
  */
 
 #include <algorithm>
+#include <array>
 #include <boost/format.hpp>
 #include <boost/functional/hash.hpp>
 #include <boost/sort/spreadsort/spreadsort.hpp>
@@ -32,6 +33,7 @@
 #include <immintrin.h>
 #endif
 
+#include "bitboard.h"
 #include "board.h"
 #include "grid.h"
 #include "gtsa.hpp"
@@ -106,49 +108,20 @@ const char kOwnerMinimizer = 2;
 
 constexpr int kGridCells = kBoardHeight * kBoardWidth;  // 130
 
-struct BitBoard {
-  uint64_t w[3] = {};
-
-  void set(int pos) { w[pos >> 6] |= 1ULL << (pos & 63); }
-  void clear(int pos) { w[pos >> 6] &= ~(1ULL << (pos & 63)); }
-  bool test(int pos) const { return w[pos >> 6] & (1ULL << (pos & 63)); }
-
-  BitBoard operator|(const BitBoard& o) const { return {{w[0]|o.w[0], w[1]|o.w[1], w[2]|o.w[2]}}; }
-  BitBoard operator&(const BitBoard& o) const { return {{w[0]&o.w[0], w[1]&o.w[1], w[2]&o.w[2]}}; }
-  BitBoard operator~() const { return {{~w[0], ~w[1], ~w[2]}}; }
-  BitBoard& operator|=(const BitBoard& o) { w[0]|=o.w[0]; w[1]|=o.w[1]; w[2]|=o.w[2]; return *this; }
-  bool any() const { return w[0] | w[1] | w[2]; }
-
-  // Shift right by n bits (n < 64). Equivalent to >> on a 192-bit integer.
-  // Cross-word carry: low bits of w[i+1] flow into high bits of w[i].
-  BitBoard shr(int n) const {
-    return {{(w[0] >> n) | (w[1] << (64 - n)),
-             (w[1] >> n) | (w[2] << (64 - n)),
-             w[2] >> n}};
-  }
-
-  // Shift left by n bits (n < 64). Equivalent to << on a 192-bit integer.
-  // Cross-word carry: high bits of w[i] flow into low bits of w[i+1].
-  BitBoard shl(int n) const {
-    return {{w[0] << n,
-             (w[1] << n) | (w[0] >> (64 - n)),
-             (w[2] << n) | (w[1] >> (64 - n))}};
-  }
-
-  // Iterate over set bits, calling f(bit_position) for each.
-  // Uses the "clear lowest set bit" trick: bits &= bits - 1.
-  template<typename F>
-  void for_each_bit(F&& f) const {
-    for (int i = 0; i < 3; i++) {
-      uint64_t bits = w[i];
-      while (bits) {
-        int bit = __builtin_ctzll(bits);
-        f(i * 64 + bit);
-        bits &= bits - 1;
-      }
+// Build a mask of every cell (y, x) for which pred(y, x) holds.
+// Evaluated at compile time: every mask below is constant-initialized
+// into read-only data, so there is no lazy init (and no init race when
+// several server threads construct states at once).
+template<typename Pred>
+constexpr BitBoard make_cell_mask(Pred pred) {
+  BitBoard mask;
+  for (int y = 0; y < kBoardHeight; y++) {
+    for (int x = 0; x < kBoardWidth; x++) {
+      if (pred(y, x)) mask.set(y * kBoardWidth + x);
     }
   }
-};
+  return mask;
+}
 
 // Column masks for bitboard shifts: prevent wrap-around across row boundaries.
 //
@@ -163,24 +136,42 @@ struct BitBoard {
 //   sRow0Mask / sRow12Mask: all cells in row 0 / row 12 (home edges).
 //     Used to extract home-edge seeds from player bitboards for flood-fill,
 //     avoiding a full grid scan.
-static BitBoard not_col_0, not_col_9;
-static BitBoard sRow0Mask, sRow12Mask;
-static bool bitboard_masks_initialized = false;
+static constexpr BitBoard not_col_0 = make_cell_mask([](int, int x) { return x != 0; });
+static constexpr BitBoard not_col_9 = make_cell_mask([](int, int x) { return x != kBoardWidth - 1; });
+static constexpr BitBoard sRow0Mask = make_cell_mask([](int y, int) { return y == 0; });
+static constexpr BitBoard sRow12Mask = make_cell_mask([](int y, int) { return y == kBoardHeight - 1; });
 
-static void init_bitboard_masks() {
-  if (bitboard_masks_initialized) return;
+// Per-cell neighborhood masks, indexed by pos = y * kBoardWidth + x.
+//
+//   sNeighborMasks[pos]:  the (up to) 8 king-move neighbors of pos. This is
+//     also the blast area of a megabomb.
+//   sBombBlastMasks[pos]: the (up to) 4 orthogonal neighbors of pos, i.e.
+//     the blast area of a regular bomb.
+//
+// Off-board neighbors are simply absent, so callers need no bounds checks.
+using CellMaskTable = std::array<BitBoard, kGridCells>;
+
+constexpr CellMaskTable make_neighbor_masks(bool includeDiagonals) {
+  CellMaskTable masks = {};
   for (int y = 0; y < kBoardHeight; y++) {
     for (int x = 0; x < kBoardWidth; x++) {
-      int pos = y * kBoardWidth + x;
-      if (x != 0) not_col_0.set(pos);
-      if (x != kBoardWidth - 1) not_col_9.set(pos);
-      if (y == 0) sRow0Mask.set(pos);
-      if (y == kBoardHeight - 1) sRow12Mask.set(pos);
+      for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+          const int ny = y + dy;
+          const int nx = x + dx;
+          if ((dy == 0 && dx == 0) || (!includeDiagonals && dy != 0 && dx != 0)) continue;
+          if (ny < 0 || ny >= kBoardHeight || nx < 0 || nx >= kBoardWidth) continue;
+          masks[y * kBoardWidth + x].set(ny * kBoardWidth + nx);
+        }
+      }
     }
   }
-  bitboard_masks_initialized = true;
+  return masks;
 }
 
+static constexpr CellMaskTable sNeighborMasks = make_neighbor_masks(true);
+static constexpr CellMaskTable sBombBlastMasks = make_neighbor_masks(false);
+
 // Expand a frontier bitboard one step in all 8 directions on the grid.
 // Each shift moves all set bits to a neighboring position simultaneously.
 // Column masks prevent horizontal wrap-around; vertical shifts (>>10, <<10)
@@ -432,8 +423,6 @@ struct WordBaseState : public State<WordBaseState, WordBaseMove> {
       mTtVerificationKey(0),
       mGoodnessAccum(0),
       mTookEnemyCell(false) {
-    init_bitboard_masks();
-    initLookupTables();
     putBomb(board->getBombs(), false);
     putBomb(board->getMegabombs(), true);
     mHashValue = computeHashFromState();
@@ -459,7 +448,7 @@ struct WordBaseState : public State<WordBaseState, WordBaseMove> {
     mSearchDepthRemaining = rhs.mSearchDepthRemaining;
   }
 
-  WordBaseState clone() const override {
+  WordBaseState clone() const {
     return WordBaseState(*this);
   }
 
@@ -515,6 +504,41 @@ struct WordBaseState : public State<WordBaseState, WordBaseMove> {
   // No-op: played word undo is now handled inside restoreSnapshot.
   void undoPlayedWords(const WordBaseMove&) {}
 
+  // Passing only flips the side to move (and its hash tokens). A real move
+  // never loses cells, so a pass is never better than the best move: there
+  // is no zugzwang to trip null-move pruning.
+  bool make_null_move() {
+    setPlayerToMove(get_enemy(player_to_move));
+    return true;
+  }
+  void undo_null_move() {
+    setPlayerToMove(get_enemy(player_to_move));
+  }
+
+  // Every move is a LegalWordId of this board.
+  int move_id_count() const { return mBoard->getLegalWordsSize(); }
+
+  // Rows between each side's furthest cell and the enemy home row (the
+  // winning edge), whichever is fewer. Player 1 plays down from row 0,
+  // player 2 up from the last row.
+  int race_distance() const {
+    int player1Row = 0;
+    for (int i = 2; i >= 0; i--) {
+      if (mPlayer1Bits.w[i]) {
+        player1Row = (i * 64 + 63 - __builtin_clzll(mPlayer1Bits.w[i])) / kBoardWidth;
+        break;
+      }
+    }
+    int player2Row = kBoardHeight - 1;
+    for (int i = 0; i < 3; i++) {
+      if (mPlayer2Bits.w[i]) {
+        player2Row = (i * 64 + __builtin_ctzll(mPlayer2Bits.w[i])) / kBoardWidth;
+        break;
+      }
+    }
+    return std::min(kBoardHeight - 1 - player1Row, player2Row);
+  }
+
   const WordBaseGridState& getGridState() const { return mState; }
   const BoardStatic& getBoardStatic() const { return *mBoard; }
 
@@ -525,7 +549,7 @@ struct WordBaseState : public State<WordBaseState, WordBaseMove> {
     }
   }
 
-  static size_t mixHashToken(uint64_t value) {
+  static constexpr size_t mixHashToken(uint64_t value) {
     value += 0x9e3779b97f4a7c15ULL;
     value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
     value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
@@ -533,7 +557,7 @@ struct WordBaseState : public State<WordBaseState, WordBaseMove> {
     return static_cast<size_t>(value);
   }
 
-  static uint64_t mixVerificationToken(uint64_t value) {
+  static constexpr uint64_t mixVerificationToken(uint64_t value) {
     value += 0x6a09e667f3bcc909ULL;
     value = (value ^ (value >> 33)) * 0xff51afd7ed558ccdULL;
     value = (value ^ (value >> 33)) * 0xc4ceb9fe1a85ec53ULL;
@@ -555,33 +579,48 @@ struct WordBaseState : public State<WordBaseState, WordBaseMove> {
   // Table size: 130 cells × 5 owners × 16 bytes (hash + verify) = 10.4 KB.
   // Fits comfortably in L1 cache (typically 32-64 KB).
   //
+  // All three tables are built by constexpr functions and constant-initialized
+  // (see the definitions after the class), so they live in read-only data and
+  // need no runtime init on state construction.
+  //
   // Owner values: PLAYER_UNOWNED=0, PLAYER_1=1, PLAYER_2=2, PLAYER_BOMB=3, PLAYER_MEGABOMB=4
   static constexpr int kMaxOwner = 5;
-  static size_t   sCellHashTable[kGridCells][kMaxOwner];
-  static uint64_t sCellVerifyTable[kGridCells][kMaxOwner];
-  static int      sGoodnessTable[kBoardHeight][kMaxOwner];
-  static bool     sTablesInitialized;
-
-  static void initLookupTables() {
-    if (sTablesInitialized) return;
+  using CellHashTable = std::array<std::array<size_t, kMaxOwner>, kGridCells>;
+  using CellVerifyTable = std::array<std::array<uint64_t, kMaxOwner>, kGridCells>;
+  using GoodnessTable = std::array<std::array<int, kMaxOwner>, kBoardHeight>;
+  static const CellHashTable   sCellHashTable;
+  static const CellVerifyTable sCellVerifyTable;
+  static const GoodnessTable   sGoodnessTable;
+
+  static constexpr CellHashTable buildCellHashTable() {
+    CellHashTable table = {};
     for (int pos = 0; pos < kGridCells; pos++) {
       for (int owner = 0; owner < kMaxOwner; owner++) {
-        const uint64_t index = static_cast<uint64_t>(pos);
-        const uint64_t ownerValue = static_cast<uint64_t>(owner);
-        sCellHashTable[pos][owner] = mixHashToken(
-            (index << 8) ^ ownerValue ^ 0x3141592653589793ULL);
-        sCellVerifyTable[pos][owner] = mixVerificationToken(
-            (index << 8) ^ ownerValue ^ 0x243f6a8885a308d3ULL);
+        table[pos][owner] = mixHashToken(
+            (static_cast<uint64_t>(pos) << 8) ^ static_cast<uint64_t>(owner) ^ 0x3141592653589793ULL);
       }
     }
-    for (int y = 0; y < kBoardHeight; y++) {
+    return table;
+  }
+
+  static constexpr CellVerifyTable buildCellVerifyTable() {
+    CellVerifyTable table = {};
+    for (int pos = 0; pos < kGridCells; pos++) {
       for (int owner = 0; owner < kMaxOwner; owner++) {
-        if (owner == PLAYER_1) sGoodnessTable[y][owner] = (y + 1) * (y + 1);
-        else if (owner == PLAYER_2) sGoodnessTable[y][owner] = -1 * (y - kBoardHeight) * (y - kBoardHeight);
-        else sGoodnessTable[y][owner] = 0;
+        table[pos][owner] = mixVerificationToken(
+            (static_cast<uint64_t>(pos) << 8) ^ static_cast<uint64_t>(owner) ^ 0x243f6a8885a308d3ULL);
       }
     }
-    sTablesInitialized = true;
+    return table;
+  }
+
+  static constexpr GoodnessTable buildGoodnessTable() {
+    GoodnessTable table = {};
+    for (int y = 0; y < kBoardHeight; y++) {
+      table[y][PLAYER_1] = (y + 1) * (y + 1);
+      table[y][PLAYER_2] = -1 * (y - kBoardHeight) * (y - kBoardHeight);
+    }
+    return table;
   }
 
   static size_t cellHashToken(int y, int x, char owner) {
@@ -592,19 +631,19 @@ struct WordBaseState : public State<WordBaseState, WordBaseMove> {
     return sCellVerifyTable[y * kBoardWidth + x][static_cast<unsigned char>(owner)];
   }
 
-  static size_t playedWordHashToken(LegalWordId legalWordId) {
+  static constexpr size_t playedWordHashToken(LegalWordId legalWordId) {
     return mixHashToken(static_cast<uint64_t>(legalWordId) ^ 0x2718281828459045ULL);
   }
 
-  static uint64_t playedWordVerificationToken(LegalWordId legalWordId) {
+  static constexpr uint64_t playedWordVerificationToken(LegalWordId legalWordId) {
     return mixVerificationToken(static_cast<uint64_t>(legalWordId) ^ 0x13198a2e03707344ULL);
   }
 
-  static size_t playerHashToken(char player) {
+  static constexpr size_t playerHashToken(char player) {
     return mixHashToken(static_cast<uint64_t>(static_cast<unsigned char>(player)) ^ 0xfeedfacecafebeefULL);
   }
 
-  static uint64_t playerVerificationToken(char player) {
+  static constexpr uint64_t playerVerificationToken(char player) {
     return mixVerificationToken(static_cast<uint64_t>(static_cast<unsigned char>(player)) ^ 0xa4093822299f31d0ULL);
   }
 
@@ -702,7 +741,7 @@ struct WordBaseState : public State<WordBaseState, WordBaseMove> {
 
   // Return the value of this board state from the perspective of the given player.
   // In other words, it should be positive if player_to_move has an advantage.
-  int get_goodness() const override {
+  int get_goodness() const {
     // Check terminal conditions on edge rows.
     for (int x = 0; x < kBoardWidth; x++) {
       if (mState.get(0, x) == PLAYER_2) {
@@ -719,7 +758,7 @@ struct WordBaseState : public State<WordBaseState, WordBaseMove> {
 
   // Return all the legal moves from this current state, only consider a maximum
   // of max_moves moves.
-  std::vector<WordBaseMove> get_legal_moves(int max_moves = INF) const override {
+  std::vector<WordBaseMove> get_legal_moves(int max_moves = INF) const {
     return get_legal_moves2(max_moves, NULL);
   }
 
@@ -811,7 +850,7 @@ struct WordBaseState : public State<WordBaseState, WordBaseMove> {
   }
 
   // Fill a caller-provided vector, reusing its heap allocation across calls.
-  void fill_legal_moves(std::vector<WordBaseMove>& out, int max_moves) const override {
+  void fill_legal_moves(std::vector<WordBaseMove>& out, int max_moves) const {
     // Collect all legal words reachable from owned cells into a bitset, then
     // iterate in goodness order (best-first).
     //
@@ -858,11 +897,232 @@ struct WordBaseState : public State<WordBaseState, WordBaseMove> {
     }
   }
 
-  char get_enemy(char player) const override {
+  // Fill out with the capture moves only, best-first: legal words whose path
+  // covers an enemy cell or a live bomb. Same reachable-word accumulator as
+  // fill_legal_moves; each candidate is then one AND of its precomputed
+  // cell mask with the target cells, so quiet words cost no decoding.
+  // Used by quiescence search (see MinimaxQuiescenceConfig).
+  void fill_capture_moves(std::vector<WordBaseMove>& out, int max_moves) const {
+    out.clear();
+    const bool isMaximizer = (this->player_to_move == PLAYER_1);
+    const BitBoard targets = captureTargets();
+
+    thread_local InlineBitset reachableWordBits;
+    const int legalWordsSize = mBoard->getLegalWordsSize();
+    reachableWordBits = InlineBitset(legalWordsSize);
+    const BitBoard& ownedCells = isMaximizer ? mPlayer1Bits : mPlayer2Bits;
+    ownedCells.for_each_bit([&](int pos) {
+      const auto& wordBits = mBoard->getLegalWords(pos / kBoardWidth, pos % kBoardWidth).wordBits(isMaximizer);
+      if (wordBits.size() != 0) {
+        reachableWordBits.or_with(wordBits);
+      }
+    });
+
+    const int nwords = (legalWordsSize + 63) >> 6;
+    const int maxMoveCount = (max_moves == INF) ? legalWordsSize : max_moves;
+    for (int w = 0; w < nwords; w++) {
+      uint64_t bits = reachableWordBits.words[w];
+      while (bits) {
+        const int renumberedGoodness = w * 64 + __builtin_ctzll(bits);
+        bits &= bits - 1;
+        if (!(mBoard->getWordCellMaskFromRenumberedGoodness(renumberedGoodness, isMaximizer) & targets).any()) {
+          continue;
+        }
+        LegalWordId legalWordId = mBoard->getLegalWordIdFromRenumberedGoodness(renumberedGoodness, isMaximizer);
+        if (!mPlayedWords[legalWordId]) {
+          out.push_back(WordBaseMove(legalWordId));
+          if (static_cast<int>(out.size()) >= maxMoveCount) {
+            return;
+          }
+        }
+      }
+    }
+  }
+
+  // Win-in-one detection (see MinimaxSelectiveConfig::win_in_one): the
+  // best unplayed word of the side to move that reaches the enemy home row.
+  bool find_winning_move(WordBaseMove& move) const {
+    LegalWordId legalWordId;
+    if (!findGoalWord(player_to_move, legalWordId)) {
+      return false;
+    }
+    move = WordBaseMove(legalWordId);
+    return true;
+  }
+
+  // Whether the enemy could win with its next move if it were its turn.
+  bool enemy_threatens_win() const {
+    LegalWordId legalWordId;
+    return findGoalWord(get_enemy(player_to_move), legalWordId);
+  }
+
+  // The moves that may stop every enemy win in one, best-first: captures
+  // (fill_capture_moves), since taking an enemy cell is the only way to
+  // take or cut off the cell a goal word starts from, and words equal to
+  // an enemy goal word, which playing marks as played. A superset: a
+  // capture elsewhere is kept, and loses to the goal word a ply later.
+  void fill_defending_moves(std::vector<WordBaseMove>& out, int max_moves) const {
+    out.clear();
+    const bool isMaximizer = (this->player_to_move == PLAYER_1);
+    const BitBoard targets = captureTargets();
+    const int legalWordsSize = mBoard->getLegalWordsSize();
+
+    // The enemy's goal words, re-indexed by this side's goodness.
+    thread_local InlineBitset blockingWordBits;
+    blockingWordBits = InlineBitset(legalWordsSize);
+    const char enemy = get_enemy(player_to_move);
+    const InlineBitset& enemyReachable = reachableGoalWords(enemy);
+    const bool enemyIsMaximizer = !isMaximizer;
+    const InlineBitset& enemyGoalBits = mBoard->getGoalWordBits(enemyIsMaximizer);
+    const int enemySpan = mBoard->getGoalWordSpan(enemyIsMaximizer);
+    for (int w = 0; w < enemySpan; w++) {
+      uint64_t bits = enemyReachable.words[w] & enemyGoalBits.words[w];
+      while (bits) {
+        const int renumberedGoodness = w * 64 + __builtin_ctzll(bits);
+        bits &= bits - 1;
+        const LegalWordId threat = mBoard->getLegalWordIdFromRenumberedGoodness(renumberedGoodness, enemyIsMaximizer);
+        if (mPlayedWords[threat]) {
+          continue;
+        }
+        for (auto legalWordId : mBoard->getEquivalentLegalWordIds(threat)) {
+          const LegalWord& legalWord = mBoard->getLegalWord(legalWordId);
+          blockingWordBits.set(isMaximizer ? legalWord.mRenumberedMaximizerGoodness : legalWord.mRenumberedMinimizerGoodness, true);
+        }
+      }
+    }
+
+    thread_local InlineBitset reachableWordBits;
+    reachableWordBits = InlineBitset(legalWordsSize);
+    const BitBoard& ownedCells = isMaximizer ? mPlayer1Bits : mPlayer2Bits;
+    ownedCells.for_each_bit([&](int pos) {
+      const auto& wordBits = mBoard->getLegalWords(pos / kBoardWidth, pos % kBoardWidth).wordBits(isMaximizer);
+      if (wordBits.size() != 0) {
+        reachableWordBits.or_with(wordBits);
+      }
+    });
+
+    const int nwords = (legalWordsSize + 63) >> 6;
+    const int maxMoveCount = (max_moves == INF) ? legalWordsSize : max_moves;
+    for (int w = 0; w < nwords; w++) {
+      uint64_t bits = reachableWordBits.words[w];
+      while (bits) {
+        const int renumberedGoodness = w * 64 + __builtin_ctzll(bits);
+        bits &= bits - 1;
+        if (!blockingWordBits[renumberedGoodness]
+            && !(mBoard->getWordCellMaskFromRenumberedGoodness(renumberedGoodness, isMaximizer) & targets).any()) {
+          continue;
+        }
+        LegalWordId legalWordId = mBoard->getLegalWordIdFromRenumberedGoodness(renumberedGoodness, isMaximizer);
+        if (!mPlayedWords[legalWordId]) {
+          out.push_back(WordBaseMove(legalWordId));
+          if (static_cast<int>(out.size()) >= maxMoveCount) {
+            return;
+          }
+        }
+      }
+    }
+  }
+
+  // Enemy cells and live bombs: what a capture move's path covers.
+  BitBoard captureTargets() const {
+    BitBoard targets = (player_to_move == PLAYER_1) ? mPlayer2Bits : mPlayer1Bits;
+    mBoard->getBombCellMask().for_each_bit([&](int pos) {
+      const char owner = mState.get(pos / kBoardWidth, pos % kBoardWidth);
+      if (owner == PLAYER_BOMB || owner == PLAYER_MEGABOMB) {
+        targets.set(pos);
+      }
+    });
+    return targets;
+  }
+
+  // player's reachable-word accumulator (as in fill_legal_moves), over the
+  // cells that start a goal word and the goal-word span only; the words
+  // past the span cannot win, so they are left stale.
+  const InlineBitset& reachableGoalWords(char player) const {
+    thread_local InlineBitset reachableWordBits;
+    const bool isMaximizer = (player == PLAYER_1);
+    const int span = mBoard->getGoalWordSpan(isMaximizer);
+    std::fill(reachableWordBits.words, reachableWordBits.words + span, 0);
+    const BitBoard startCells = (isMaximizer ? mPlayer1Bits : mPlayer2Bits) & mBoard->getGoalStartCells(isMaximizer);
+    startCells.for_each_bit([&](int pos) {
+      const auto& wordBits = mBoard->getLegalWords(pos / kBoardWidth, pos % kBoardWidth).wordBits(isMaximizer);
+      if (wordBits.size() != 0) {
+        for (int w = 0; w < span; w++) {
+          reachableWordBits.words[w] |= wordBits.words[w];
+        }
+      }
+    });
+    return reachableWordBits;
+  }
+
+  // The best unplayed goal word player can play: one AND of its reachable
+  // words with BoardStatic::getGoalWordBits. Away from the enemy home row
+  // no owned cell starts a goal word, and one BitBoard AND says so.
+  bool findGoalWord(char player, LegalWordId& legalWordId) const {
+    const bool isMaximizer = (player == PLAYER_1);
+    if (!((isMaximizer ? mPlayer1Bits : mPlayer2Bits) & mBoard->getGoalStartCells(isMaximizer)).any()) {
+      return false;
+    }
+    const InlineBitset& reachable = reachableGoalWords(player);
+    const InlineBitset& goalBits = mBoard->getGoalWordBits(isMaximizer);
+    const int span = mBoard->getGoalWordSpan(isMaximizer);
+    for (int w = 0; w < span; w++) {
+      uint64_t bits = reachable.words[w] & goalBits.words[w];
+      while (bits) {
+        const int renumberedGoodness = w * 64 + __builtin_ctzll(bits);
+        bits &= bits - 1;
+        legalWordId = mBoard->getLegalWordIdFromRenumberedGoodness(renumberedGoodness, isMaximizer);
+        if (!mPlayedWords[legalWordId]) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  // Return the number of legal moves available to player, without building
+  // the move list. player need not be the side to move, so evaluation can ask
+  // for the opponent's mobility too.
+  //
+  // ORs the per-cell word bitsets of the player's cells (same accumulator as
+  // fill_legal_moves), popcounts it, then subtracts the played words that are
+  // still in the accumulator. Played words are few, so walking mPlayedWords
+  // is much cheaper than decoding every reachable word. No max_moves cap.
+  int count_legal_moves(char player) const {
+    thread_local InlineBitset reachableWordBits;
+    const int legalWordsSize = mBoard->getLegalWordsSize();
+    reachableWordBits = InlineBitset(legalWordsSize);
+
+    const bool isMaximizer = (player == PLAYER_1);
+    const BitBoard& ownedCells = isMaximizer ? mPlayer1Bits : mPlayer2Bits;
+    ownedCells.for_each_bit([&](int pos) {
+      const auto& wordBits = mBoard->getLegalWords(pos / kBoardWidth, pos % kBoardWidth).wordBits(isMaximizer);
+      if (wordBits.size() != 0) {
+        reachableWordBits.or_with(wordBits);
+      }
+    });
+
+    int count = reachableWordBits.count();
+    const int nwords = (legalWordsSize + 63) >> 6;
+    for (int w = 0; w < nwords; w++) {
+      uint64_t bits = mPlayedWords.words[w];
+      while (bits) {
+        const LegalWordId legalWordId = w * 64 + __builtin_ctzll(bits);
+        bits &= bits - 1;
+        const LegalWord& legalWord = mBoard->getLegalWord(legalWordId);
+        if (reachableWordBits[isMaximizer ? legalWord.mRenumberedMaximizerGoodness : legalWord.mRenumberedMinimizerGoodness]) {
+          --count;
+        }
+      }
+    }
+    return count;
+  }
+
+  char get_enemy(char player) const {
     return (player == PLAYER_1) ? PLAYER_2 : PLAYER_1;
   }
 
-  bool is_terminal() const override {
+  bool is_terminal() const {
     for (int x = 0; x < kBoardWidth; x++) {
       if (mState.get(0, x) == PLAYER_2) {
         return true;
@@ -878,7 +1138,7 @@ struct WordBaseState : public State<WordBaseState, WordBaseMove> {
   }
 
   // FIX-ME combine with a combined is_terminal.
-  bool is_winner(char player) const override {
+  bool is_winner(char player) const {
     for (int x = 0; x < kBoardWidth; x++) {
       if (player == PLAYER_2) {
         if (mState.get(0, x) == PLAYER_2) {
@@ -896,10 +1156,6 @@ struct WordBaseState : public State<WordBaseState, WordBaseMove> {
   // Deal with the impacts of bombs by recursing, as appropriate.
   // Sets mTookEnemyCell if an enemy cell is overwritten.
   void recordOne(int y, int x) {
-    if (y < 0 || y >= kBoardHeight || x < 0 || x >= kBoardWidth) {
-      return;
-    }
-
     const char currentOwner = mState.get(y, x);
     bool hadBomb = (currentOwner == PLAYER_BOMB);
     bool hadMegabomb = (currentOwner == PLAYER_MEGABOMB);
@@ -910,26 +1166,19 @@ struct WordBaseState : public State<WordBaseState, WordBaseMove> {
     setCellState(y, x, player_to_move);
 
     // A bomb causes the player to get the grid squares North, South, East and
-    // West of this grid square.
-    if (hadBomb) {
-      recordOne(y - 1, x);
-      recordOne(y + 1, x);
-      recordOne(y, x - 1);
-      recordOne(y, x + 1);
-    } else if (hadMegabomb) {
-      recordOne(y - 1, x);
-      recordOne(y - 1, x + 1);
-      recordOne(y - 1, x - 1);
-      recordOne(y, x - 1);
-      recordOne(y, x + 1);
-      recordOne(y + 1, x);
-      recordOne(y + 1, x + 1);
-      recordOne(y + 1, x - 1);
+    // West of this grid square; a megabomb also takes the diagonals. The blast
+    // masks only contain on-board cells, so no bounds checks are needed.
+    if (hadBomb || hadMegabomb) {
+      const int pos = y * kBoardWidth + x;
+      const BitBoard& blast = hadBomb ? sBombBlastMasks[pos] : sNeighborMasks[pos];
+      blast.for_each_bit([&](int cell) {
+        recordOne(cell / kBoardWidth, cell % kBoardWidth);
+      });
     }
   }
 
   // Check whether a move is valid for the current player.
-  bool isValidMove(const WordBaseMove& move) const override {
+  bool isValidMove(const WordBaseMove& move) const {
     if (move.mLegalWordId < 0 || move.mLegalWordId >= static_cast<int>(mPlayedWords.size())) {
       return false;
     }
@@ -959,7 +1208,7 @@ struct WordBaseState : public State<WordBaseState, WordBaseMove> {
   }
 
   // Make a move, change the current player to the other after doing this.
-  void make_move(const WordBaseMove& move) override {
+  void make_move(const WordBaseMove& move) {
     // Make the move.
     recordMove(move);
 
@@ -1010,19 +1259,19 @@ struct WordBaseState : public State<WordBaseState, WordBaseMove> {
     setPlayerToMove(get_enemy(player_to_move));
   }
 
-  std::ostream &to_stream(std::ostream &os) const override {
+  std::ostream &to_stream(std::ostream &os) const {
     return os;
   }
 
-  bool operator==(const WordBaseState &other) const override {
+  bool operator==(const WordBaseState &other) const {
     return player_to_move == other.player_to_move && mState == other.mState && mPlayedWords == other.mPlayedWords;
   }
 
-  size_t hash() const override {
+  size_t hash() const {
     return mHashValue;
   }
 
-  uint64_t tt_verification_key() const override {
+  uint64_t tt_verification_key() const {
     return mTtVerificationKey;
   }
 
@@ -1049,11 +1298,10 @@ struct WordBaseState : public State<WordBaseState, WordBaseMove> {
   }
 };
 
-// Static member definitions for precomputed lookup tables.
-size_t   WordBaseState::sCellHashTable[kGridCells][WordBaseState::kMaxOwner];
-uint64_t WordBaseState::sCellVerifyTable[kGridCells][WordBaseState::kMaxOwner];
-int      WordBaseState::sGoodnessTable[kBoardHeight][WordBaseState::kMaxOwner];
-bool     WordBaseState::sTablesInitialized = false;
+// Static member definitions for precomputed lookup tables (compile-time).
+constexpr WordBaseState::CellHashTable   WordBaseState::sCellHashTable   = WordBaseState::buildCellHashTable();
+constexpr WordBaseState::CellVerifyTable WordBaseState::sCellVerifyTable = WordBaseState::buildCellVerifyTable();
+constexpr WordBaseState::GoodnessTable   WordBaseState::sGoodnessTable   = WordBaseState::buildGoodnessTable();
 
 // Print out a move sequence.
 std::ostream& operator<<(std::ostream& os, const CoordinateList& foo) {
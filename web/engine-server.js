@@ -9,7 +9,15 @@ const DICT_PATH = path.resolve(__dirname, '../src/twl06_with_wordbase_additions.
 console.log('Starting engine:', ENGINE_PATH);
 console.log('Dictionary:', DICT_PATH);
 
-const engine = spawn(ENGINE_PATH, [DICT_PATH], {
+// Optional opening books (see wordbase-book-build), separated by ':'.
+const BOOK_PATHS = (process.env.ENGINE_BOOKS || '').split(':').filter(Boolean);
+const engineArgs = [DICT_PATH];
+for (const book of BOOK_PATHS) {
+  console.log('Opening book:', book);
+  engineArgs.push('--book', path.resolve(book));
+}
+
+const engine = spawn(ENGINE_PATH, engineArgs, {
   stdio: ['pipe', 'pipe', 'inherit'],
 });
 